@@ -66,8 +66,8 @@ KeyedService* BraveNewsControllerFactory::BuildServiceInstanceFor(
   auto* ads_service = brave_ads::AdsServiceFactory::GetForProfile(profile);
   auto* history_service = HistoryServiceFactory::GetForProfile(
       profile, ServiceAccessType::EXPLICIT_ACCESS);
-  return new BraveNewsController(profile->GetPrefs(), ads_service,
-                                 history_service,
+  return new BraveNewsController(profile->GetPath(), profile->GetPrefs(),
+                                 ads_service, history_service,
                                  profile->GetURLLoaderFactory());
 }
 
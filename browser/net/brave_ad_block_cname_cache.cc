@@ -0,0 +1,74 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_ad_block_cname_cache.h"
+
+#include <memory>
+
+#include "base/time/default_tick_clock.h"
+#include "base/time/tick_clock.h"
+#include "content/public/browser/browser_context.h"
+
+namespace brave {
+
+namespace {
+
+// User data key for AdBlockCnameCache.
+const void* const kAdBlockCnameCacheUserDataKey =
+    &kAdBlockCnameCacheUserDataKey;
+
+constexpr size_t kMaxEntries = 1000;
+
+// The resolver doesn't report record TTLs over mojo, so use the same lifetime
+// the network service gives entries from the system resolver.
+constexpr base::TimeDelta kEntryTTL = base::Minutes(1);
+
+}  // namespace
+
+AdBlockCnameCache::AdBlockCnameCache(const base::TickClock* tick_clock)
+    : entries_(kMaxEntries), tick_clock_(tick_clock) {}
+
+AdBlockCnameCache::~AdBlockCnameCache() = default;
+
+// static
+AdBlockCnameCache* AdBlockCnameCache::GetOrCreateForBrowserContext(
+    content::BrowserContext* browser_context) {
+  DCHECK(browser_context);
+  auto* self = static_cast<AdBlockCnameCache*>(
+      browser_context->GetUserData(kAdBlockCnameCacheUserDataKey));
+  if (!self) {
+    self = new AdBlockCnameCache(base::DefaultTickClock::GetInstance());
+    browser_context->SetUserData(kAdBlockCnameCacheUserDataKey,
+                                 base::WrapUnique(self));
+  }
+  return self;
+}
+
+absl::optional<std::string> AdBlockCnameCache::Get(
+    const net::NetworkIsolationKey& network_isolation_key,
+    const std::string& host) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = entries_.Get({network_isolation_key, host});
+  if (it == entries_.end())
+    return absl::nullopt;
+
+  if (tick_clock_->NowTicks() >= it->second.expiration) {
+    entries_.Erase(it);
+    return absl::nullopt;
+  }
+
+  return it->second.canonical_name;
+}
+
+void AdBlockCnameCache::Put(
+    const net::NetworkIsolationKey& network_isolation_key,
+    const std::string& host,
+    const std::string& canonical_name) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  entries_.Put({network_isolation_key, host},
+               {canonical_name, tick_clock_->NowTicks() + kEntryTTL});
+}
+
+}  // namespace brave
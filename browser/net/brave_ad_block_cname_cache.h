@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_BRAVE_AD_BLOCK_CNAME_CACHE_H_
+#define BRAVE_BROWSER_NET_BRAVE_AD_BLOCK_CNAME_CACHE_H_
+
+#include <string>
+#include <utility>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "net/base/network_isolation_key.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace base {
+class TickClock;
+}  // namespace base
+
+namespace content {
+class BrowserContext;
+}  // namespace content
+
+namespace brave {
+
+// Remembers the canonical names found while CNAME uncloaking adblock requests,
+// so that further subresources from the same host don't each need a DNS round
+// trip. Entries are partitioned by NetworkIsolationKey, like the host cache
+// of the network service. There is one cache per profile, used on the UI
+// thread.
+class AdBlockCnameCache : public base::SupportsUserData::Data {
+ public:
+  explicit AdBlockCnameCache(const base::TickClock* tick_clock);
+  AdBlockCnameCache(const AdBlockCnameCache&) = delete;
+  AdBlockCnameCache& operator=(const AdBlockCnameCache&) = delete;
+  ~AdBlockCnameCache() override;
+
+  static AdBlockCnameCache* GetOrCreateForBrowserContext(
+      content::BrowserContext* browser_context);
+
+  // Returns the canonical name of |host|, which is empty if the host has no
+  // alias, or absl::nullopt if it isn't cached or has expired.
+  absl::optional<std::string> Get(
+      const net::NetworkIsolationKey& network_isolation_key,
+      const std::string& host);
+  void Put(const net::NetworkIsolationKey& network_isolation_key,
+           const std::string& host,
+           const std::string& canonical_name);
+
+  size_t size() const { return entries_.size(); }
+
+  base::WeakPtr<AdBlockCnameCache> AsWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ private:
+  using Key = std::pair<net::NetworkIsolationKey, std::string>;
+  struct Entry {
+    std::string canonical_name;
+    base::TimeTicks expiration;
+  };
+
+  base::LRUCache<Key, Entry> entries_;
+  raw_ptr<const base::TickClock> tick_clock_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<AdBlockCnameCache> weak_factory_{this};
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_BRAVE_AD_BLOCK_CNAME_CACHE_H_
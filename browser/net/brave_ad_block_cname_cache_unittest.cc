@@ -0,0 +1,68 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_ad_block_cname_cache.h"
+
+#include "base/test/simple_test_tick_clock.h"
+#include "net/base/schemeful_site.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+net::NetworkIsolationKey CreateNetworkIsolationKey(const std::string& url) {
+  const net::SchemefulSite site(GURL(url));
+  return net::NetworkIsolationKey(site, site);
+}
+
+}  // namespace
+
+TEST(AdBlockCnameCacheTest, CachesCanonicalName) {
+  base::SimpleTestTickClock clock;
+  AdBlockCnameCache cache(&clock);
+  const auto key = CreateNetworkIsolationKey("https://example.com");
+
+  EXPECT_FALSE(cache.Get(key, "tracker.example.com"));
+
+  cache.Put(key, "tracker.example.com", "tracker.adserver.com");
+  cache.Put(key, "cdn.example.com", "");
+
+  EXPECT_EQ(cache.Get(key, "tracker.example.com"), "tracker.adserver.com");
+  // Hosts without an alias are cached too, so they aren't resolved again.
+  EXPECT_EQ(cache.Get(key, "cdn.example.com"), "");
+}
+
+TEST(AdBlockCnameCacheTest, PartitionedByNetworkIsolationKey) {
+  base::SimpleTestTickClock clock;
+  AdBlockCnameCache cache(&clock);
+
+  cache.Put(CreateNetworkIsolationKey("https://a.com"), "tracker.example.com",
+            "tracker.adserver.com");
+
+  EXPECT_TRUE(
+      cache.Get(CreateNetworkIsolationKey("https://a.com"),
+                "tracker.example.com"));
+  EXPECT_FALSE(
+      cache.Get(CreateNetworkIsolationKey("https://b.com"),
+                "tracker.example.com"));
+}
+
+TEST(AdBlockCnameCacheTest, EntriesExpire) {
+  base::SimpleTestTickClock clock;
+  AdBlockCnameCache cache(&clock);
+  const auto key = CreateNetworkIsolationKey("https://example.com");
+
+  cache.Put(key, "tracker.example.com", "tracker.adserver.com");
+  clock.Advance(base::Seconds(30));
+  EXPECT_TRUE(cache.Get(key, "tracker.example.com"));
+
+  clock.Advance(base::Seconds(30));
+  EXPECT_FALSE(cache.Get(key, "tracker.example.com"));
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+}  // namespace brave
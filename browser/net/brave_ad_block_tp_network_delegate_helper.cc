@@ -17,6 +17,7 @@
 #include "base/strings/string_util.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/browser/net/brave_ad_block_cname_cache.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/url_constants.h"
@@ -31,6 +32,7 @@
 #include "components/prefs/pref_service.h"
 #include "components/proxy_config/pref_proxy_config_tracker.h"
 #include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/storage_partition.h"
@@ -84,13 +86,20 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
   mojo::Receiver<network::mojom::ResolveHostClient> receiver_{this};
   base::OnceCallback<void(absl::optional<std::string>)> cb_;
   base::TimeTicks start_time_;
+  base::WeakPtr<AdBlockCnameCache> cname_cache_;
+  net::NetworkIsolationKey network_isolation_key_;
+  std::string host_;
 
  public:
   AdblockCnameResolveHostClient(
       const ResponseCallback& next_callback,
       scoped_refptr<base::SequencedTaskRunner> task_runner,
       std::shared_ptr<BraveRequestInfo> ctx,
-      EngineFlags previous_result) {
+      EngineFlags previous_result,
+      base::WeakPtr<AdBlockCnameCache> cname_cache)
+      : cname_cache_(std::move(cname_cache)),
+        network_isolation_key_(ctx->network_isolation_key),
+        host_(ctx->request_url.host()) {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     cb_ = base::BindOnce(&UseCnameResult, task_runner, std::move(next_callback),
                          ctx, previous_result);
@@ -150,8 +159,12 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
                         base::TimeTicks::Now() - start_time_);
     if (result == net::OK && resolved_addresses) {
       DCHECK(resolved_addresses.has_value() && !resolved_addresses->empty());
-      std::move(cb_).Run(absl::optional<std::string>(
-          GetCanonicalName(resolved_addresses.value().dns_aliases())));
+      const std::string& canonical_name =
+          GetCanonicalName(resolved_addresses.value().dns_aliases());
+      if (cname_cache_) {
+        cname_cache_->Put(network_isolation_key_, host_, canonical_name);
+      }
+      std::move(cb_).Run(absl::optional<std::string>(canonical_name));
     } else {
       std::move(cb_).Run(absl::nullopt);
     }
@@ -170,6 +183,13 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
   }
 };
 
+bool ShouldForceAggressiveBlocking(const BraveRequestInfo& ctx) {
+  return SameDomainOrHost(
+      ctx.initiator_url,
+      url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
+      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+}
+
 // If `canonical_url` is specified, this will only check if the CNAME-uncloaked
 // response should be blocked. Otherwise, it will run the check for the
 // original request URL.
@@ -189,10 +209,7 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
     url_to_check = ctx->request_url;
   }
 
-  bool force_aggressive = SameDomainOrHost(
-      ctx->initiator_url,
-      url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
-      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  bool force_aggressive = ShouldForceAggressiveBlocking(*ctx);
 
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.Adblock.ShouldBlockRequest");
   g_brave_browser_process->ad_block_service()->ShouldStartRequest(
@@ -210,6 +227,66 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
   return previous_result;
 }
 
+// Batched version of `ShouldBlockRequestOnTaskRunner` for the first check of
+// each request, so that requests arriving together share a single pass through
+// the adblock engines.
+std::vector<EngineFlags> ShouldBlockRequestsOnTaskRunner(
+    std::vector<std::shared_ptr<BraveRequestInfo>> ctxs) {
+  std::vector<EngineFlags> flags(ctxs.size());
+
+  std::vector<brave_shields::AdBlockMatchRequest> requests;
+  std::vector<size_t> ctx_indices;
+  requests.reserve(ctxs.size());
+  ctx_indices.reserve(ctxs.size());
+  for (size_t i = 0; i < ctxs.size(); ++i) {
+    const auto& ctx = ctxs[i];
+    if (!ctx->initiator_url.is_valid()) {
+      continue;
+    }
+    brave_shields::AdBlockMatchRequest request;
+    request.url = ctx->request_url;
+    request.resource_type = ctx->resource_type;
+    request.tab_host = ctx->initiator_url.host();
+    request.aggressive_blocking =
+        ctx->aggressive_blocking || ShouldForceAggressiveBlocking(*ctx);
+    requests.push_back(std::move(request));
+    ctx_indices.push_back(i);
+  }
+
+  if (requests.empty()) {
+    return flags;
+  }
+
+  std::vector<brave_shields::AdBlockMatchResult> results(requests.size());
+  {
+    SCOPED_UMA_HISTOGRAM_TIMER("Brave.Adblock.ShouldBlockRequests");
+    g_brave_browser_process->ad_block_service()->ShouldStartRequests(requests,
+                                                                     results);
+  }
+  UMA_HISTOGRAM_COUNTS_1000("Brave.Adblock.ShouldBlockRequests.BatchSize",
+                            requests.size());
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& result = results[i];
+    const size_t ctx_index = ctx_indices[i];
+    auto& ctx = ctxs[ctx_index];
+    EngineFlags& engine_flags = flags[ctx_index];
+    engine_flags.did_match_rule = result.did_match_rule;
+    engine_flags.did_match_exception = result.did_match_exception;
+    engine_flags.did_match_important = result.did_match_important;
+    if (!result.mock_data_url.empty()) {
+      ctx->mock_data_url = result.mock_data_url;
+    }
+
+    if (engine_flags.did_match_important ||
+        (engine_flags.did_match_rule && !engine_flags.did_match_exception)) {
+      ctx->blocked_by = kAdBlocked;
+    }
+  }
+
+  return flags;
+}
+
 void OnShouldBlockRequestResult(
     bool then_check_uncloaked,
     scoped_refptr<base::SequencedTaskRunner> task_runner,
@@ -221,14 +298,79 @@ void OnShouldBlockRequestResult(
     brave_shields::BraveShieldsWebContentsObserver::DispatchBlockedEvent(
         ctx->request_url, ctx->frame_tree_node_id, brave_shields::kAds);
   } else if (then_check_uncloaked) {
+    base::WeakPtr<AdBlockCnameCache> cname_cache;
+    if (ctx->browser_context) {
+      cname_cache =
+          AdBlockCnameCache::GetOrCreateForBrowserContext(ctx->browser_context)
+              ->AsWeakPtr();
+      absl::optional<std::string> cname = cname_cache->Get(
+          ctx->network_isolation_key, ctx->request_url.host());
+      UMA_HISTOGRAM_BOOLEAN("Brave.ShieldsCNAMEBlocking.CacheHit",
+                            cname.has_value());
+      if (cname) {
+        UseCnameResult(task_runner, next_callback, ctx, result,
+                       std::move(cname));
+        return;
+      }
+    }
     // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
     new AdblockCnameResolveHostClient(std::move(next_callback), task_runner,
-                                      ctx, result);
+                                      ctx, result, std::move(cname_cache));
     return;
   }
   next_callback.Run();
 }
 
+// A request waiting for the current batch to be sent to the adblock engines.
+struct PendingAdBlockCheck {
+  ResponseCallback next_callback;
+  std::shared_ptr<BraveRequestInfo> ctx;
+  bool should_check_uncloaked;
+};
+
+std::vector<PendingAdBlockCheck>& GetPendingAdBlockChecks() {
+  static base::NoDestructor<std::vector<PendingAdBlockCheck>> pending_checks;
+  return *pending_checks;
+}
+
+void OnShouldBlockRequestsResult(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    std::vector<PendingAdBlockCheck> checks,
+    std::vector<EngineFlags> results) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_EQ(checks.size(), results.size());
+  for (size_t i = 0; i < checks.size(); ++i) {
+    OnShouldBlockRequestResult(checks[i].should_check_uncloaked, task_runner,
+                               checks[i].next_callback, checks[i].ctx,
+                               results[i]);
+  }
+}
+
+// Sends every request queued during the previous UI task to the adblock task
+// runner in a single hop.
+void FlushPendingAdBlockChecks() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  std::vector<PendingAdBlockCheck> checks;
+  checks.swap(GetPendingAdBlockChecks());
+  if (checks.empty()) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<BraveRequestInfo>> ctxs;
+  ctxs.reserve(checks.size());
+  for (const auto& check : checks) {
+    ctxs.push_back(check.ctx);
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner =
+      g_brave_browser_process->ad_block_service()->GetTaskRunner();
+  task_runner->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ShouldBlockRequestsOnTaskRunner, std::move(ctxs)),
+      base::BindOnce(&OnShouldBlockRequestsResult, task_runner,
+                     std::move(checks)));
+}
+
 void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     const ResponseCallback& next_callback,
                     std::shared_ptr<BraveRequestInfo> ctx,
@@ -314,9 +456,6 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
   DCHECK(!ctx->request_url.is_empty());
   DCHECK(!ctx->initiator_url.is_empty());
 
-  scoped_refptr<base::SequencedTaskRunner> task_runner =
-      g_brave_browser_process->ad_block_service()->GetTaskRunner();
-
   SecureDnsConfig secure_dns_config =
       SystemNetworkContextManager::GetStubResolverConfigReader()
           ->GetSecureDnsConfiguration(false);
@@ -345,12 +484,14 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
     should_check_uncloaked = false;
   }
 
-  task_runner->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, EngineFlags(),
-                     absl::nullopt),
-      base::BindOnce(&OnShouldBlockRequestResult, should_check_uncloaked,
-                     task_runner, next_callback, ctx));
+  // Requests arriving within the same task-loop turn are coalesced and
+  // checked together once the current task has finished.
+  auto& pending_checks = GetPendingAdBlockChecks();
+  if (pending_checks.empty()) {
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE, base::BindOnce(&FlushPendingAdBlockChecks));
+  }
+  pending_checks.push_back({next_callback, ctx, should_check_uncloaked});
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
@@ -226,3 +226,30 @@ TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, SimpleBlocking) {
   // made (`browser_context` is `nullptr`).
   EXPECT_EQ(0ULL, host_resolver_->num_resolve());
 }
+
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, BatchedBlocking) {
+  ResetAdblockInstance("||brave.com/test.txt", "");
+
+  // Both requests arrive within the same task, so they're matched as a single
+  // batch.
+  auto blocked_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://brave.com/test.txt"));
+  blocked_info->request_identifier = 1;
+  blocked_info->resource_type = blink::mojom::ResourceType::kScript;
+  blocked_info->initiator_url = GURL("https://brave.com");
+
+  auto allowed_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://brave.com/other.txt"));
+  allowed_info->request_identifier = 2;
+  allowed_info->resource_type = blink::mojom::ResourceType::kScript;
+  allowed_info->initiator_url = GURL("https://brave.com");
+
+  EXPECT_EQ(net::ERR_IO_PENDING, OnBeforeURLRequest_AdBlockTPPreWork(
+                                     base::DoNothing(), blocked_info));
+  EXPECT_EQ(net::ERR_IO_PENDING, OnBeforeURLRequest_AdBlockTPPreWork(
+                                     base::DoNothing(), allowed_info));
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(blocked_info->blocked_by, brave::kAdBlocked);
+  EXPECT_EQ(allowed_info->blocked_by, brave::kNotBlocked);
+}
@@ -6,10 +6,12 @@
 #include "brave/browser/net/brave_request_handler.h"
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
 #include "base/containers/contains.h"
 #include "base/feature_list.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/task/post_task.h"
 #include "brave/browser/net/brave_ad_block_csp_network_delegate_helper.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
@@ -59,6 +61,16 @@ static bool IsInternalScheme(std::shared_ptr<brave::BraveRequestInfo> ctx) {
   return ctx->request_url.SchemeIs(content::kChromeUIScheme);
 }
 
+BraveRequestHandler::BeforeURLRequestStage::BeforeURLRequestStage(
+    const char* name,
+    brave::OnBeforeURLRequestCallback callback)
+    : name(name), callback(std::move(callback)) {}
+
+BraveRequestHandler::BeforeURLRequestStage::BeforeURLRequestStage(
+    const BeforeURLRequestStage&) = default;
+
+BraveRequestHandler::BeforeURLRequestStage::~BeforeURLRequestStage() = default;
+
 BraveRequestHandler::BraveRequestHandler() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   SetupCallbacks();
@@ -67,33 +79,37 @@ BraveRequestHandler::BraveRequestHandler() {
 BraveRequestHandler::~BraveRequestHandler() = default;
 
 void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestStage(
+      "SiteHacks", base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork));
+
+  // Adblock only sets |blocked_by| and |mock_data_url|, while HTTPSE only
+  // sets |new_url_spec|, so the two lookups can run at the same time.
+  AddBeforeURLRequestStage(
+      "AdBlockTP",
+      base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork));
+  AddBeforeURLRequestStage(
+      "HTTPSE", base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork),
+      true);
+
+  AddBeforeURLRequestStage(
+      "CommonStaticRedirect",
+      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 
 #if BUILDFLAG(DECENTRALIZED_DNS_ENABLED)
-  callback = base::BindRepeating(
-      decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestStage(
+      "DecentralizedDns",
+      base::BindRepeating(decentralized_dns::
+                              OnBeforeURLRequest_DecentralizedDnsPreRedirectWork));
 #endif
 
-  callback = base::BindRepeating(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestStage(
+      "Rewards", base::BindRepeating(brave_rewards::OnBeforeURLRequest));
 
 #if BUILDFLAG(ENABLE_IPFS)
   if (base::FeatureList::IsEnabled(ipfs::features::kIpfsFeature)) {
-    callback = base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork);
-    before_url_request_callbacks_.push_back(callback);
+    AddBeforeURLRequestStage(
+        "IPFSRedirect",
+        base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork));
     brave::OnHeadersReceivedCallback ipfs_headers_received_callback =
         base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork);
     headers_received_callbacks_.push_back(ipfs_headers_received_callback);
@@ -132,6 +148,16 @@ void BraveRequestHandler::SetupCallbacks() {
   }
 }
 
+void BraveRequestHandler::AddBeforeURLRequestStage(
+    const char* name,
+    brave::OnBeforeURLRequestCallback callback,
+    bool run_with_previous) {
+  if (!run_with_previous || before_url_request_stages_.empty()) {
+    before_url_request_stages_.emplace_back();
+  }
+  before_url_request_stages_.back().emplace_back(name, std::move(callback));
+}
+
 bool BraveRequestHandler::IsRequestIdentifierValid(
     uint64_t request_identifier) {
   return base::Contains(callbacks_, request_identifier);
@@ -141,7 +167,7 @@ int BraveRequestHandler::OnBeforeURLRequest(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  if (before_url_request_callbacks_.empty() || IsInternalScheme(ctx)) {
+  if (before_url_request_stages_.empty() || IsInternalScheme(ctx)) {
     return net::OK;
   }
   ctx->new_url = new_url;
@@ -225,20 +251,9 @@ void BraveRequestHandler::RunNextCallback(
   int rv = net::OK;
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
-    while (before_url_request_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::BindRepeating(&BraveRequestHandler::RunNextCallback,
-                              weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
+    rv = RunBeforeURLRequestStages(ctx);
+    if (rv == net::ERR_IO_PENDING) {
+      return;
     }
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
@@ -297,3 +312,60 @@ void BraveRequestHandler::RunNextCallback(
   }
   RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
 }
+
+int BraveRequestHandler::RunBeforeURLRequestStages(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_EQ(ctx->pending_url_request_callbacks, 0);
+
+  while (ctx->url_request_callbacks_rv == net::OK &&
+         before_url_request_stages_.size() != ctx->next_url_request_index) {
+    const auto& stages =
+        before_url_request_stages_[ctx->next_url_request_index++];
+    // Hold an extra count while starting the stages, so that a stage that
+    // completes synchronously can't resume the pipeline from under us.
+    ctx->pending_url_request_callbacks = 1;
+    for (const auto& stage : stages) {
+      const base::TimeTicks start = base::TimeTicks::Now();
+      ++ctx->pending_url_request_callbacks;
+      brave::ResponseCallback next_callback = base::BindRepeating(
+          &BraveRequestHandler::OnBeforeURLRequestStageComplete,
+          weak_factory_.GetWeakPtr(), ctx, stage.name, start);
+      const int rv = stage.callback.Run(next_callback, ctx);
+      if (rv == net::ERR_IO_PENDING) {
+        continue;
+      }
+      --ctx->pending_url_request_callbacks;
+      base::UmaHistogramTimes(
+          std::string("Brave.RequestHandler.OnBeforeURLRequest.") + stage.name,
+          base::TimeTicks::Now() - start);
+      if (rv != net::OK) {
+        // Stages are started in order, so this is the same error a sequential
+        // run would have stopped at.
+        ctx->url_request_callbacks_rv = rv;
+        break;
+      }
+    }
+    if (--ctx->pending_url_request_callbacks > 0) {
+      return net::ERR_IO_PENDING;
+    }
+  }
+
+  return ctx->url_request_callbacks_rv;
+}
+
+void BraveRequestHandler::OnBeforeURLRequestStageComplete(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    const char* name,
+    base::TimeTicks start) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  base::UmaHistogramTimes(
+      std::string("Brave.RequestHandler.OnBeforeURLRequest.") + name,
+      base::TimeTicks::Now() - start);
+
+  DCHECK_GT(ctx->pending_url_request_callbacks, 0);
+  if (--ctx->pending_url_request_callbacks > 0) {
+    return;
+  }
+  RunNextCallback(ctx);
+}
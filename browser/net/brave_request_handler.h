@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include "base/time/time.h"
 #include "brave/browser/net/url_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/completion_once_callback.h"
@@ -46,10 +47,36 @@ class BraveRequestHandler {
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  private:
+  // A named OnBeforeURLRequest callback, the name is used for its latency
+  // histogram.
+  struct BeforeURLRequestStage {
+    BeforeURLRequestStage(const char* name,
+                          brave::OnBeforeURLRequestCallback callback);
+    BeforeURLRequestStage(const BeforeURLRequestStage&);
+    ~BeforeURLRequestStage();
+
+    const char* name;
+    brave::OnBeforeURLRequestCallback callback;
+  };
+
   void SetupCallbacks();
+  // Adds a stage that runs once all previously added stages are done. With
+  // |run_with_previous|, the stage is instead started alongside the stages
+  // of the previous call, because it doesn't depend on their results.
+  void AddBeforeURLRequestStage(const char* name,
+                                brave::OnBeforeURLRequestCallback callback,
+                                bool run_with_previous = false);
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Returns ERR_IO_PENDING while stages are still running.
+  int RunBeforeURLRequestStages(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  void OnBeforeURLRequestStageComplete(
+      std::shared_ptr<brave::BraveRequestInfo> ctx,
+      const char* name,
+      base::TimeTicks start);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
+  // Groups of stages, run one group after the other. All stages of a group
+  // are started together and the next group starts when they're all done.
+  std::vector<std::vector<BeforeURLRequestStage>> before_url_request_stages_;
   std::vector<brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
   std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
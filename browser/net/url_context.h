@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "net/base/net_errors.h"
 #include "net/base/network_isolation_key.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
@@ -87,6 +88,10 @@ struct BraveRequestInfo {
   int frame_tree_node_id = 0;
   uint64_t request_identifier = 0;
   size_t next_url_request_index = 0;
+  // Used by BraveRequestHandler to wait for OnBeforeURLRequest callbacks that
+  // were started together, and for the first error any of them returned.
+  int pending_url_request_callbacks = 0;
+  int url_request_callbacks_rv = net::OK;
 
   content::BrowserContext* browser_context = nullptr;
   net::HttpRequestHeaders* headers = nullptr;
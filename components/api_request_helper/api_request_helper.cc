@@ -7,16 +7,135 @@
 
 #include <utility>
 
+#include "base/bind.h"
+#include "base/callback_helpers.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 
 namespace api_request_helper {
 
+namespace {
+
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+void GetResponseInfo(network::SimpleURLLoader* loader,
+                     int* response_code,
+                     base::flat_map<std::string, std::string>* headers) {
+  *response_code = -1;
+  if (!loader->ResponseInfo())
+    return;
+  auto headers_list = loader->ResponseInfo()->headers;
+  if (!headers_list)
+    return;
+  *response_code = headers_list->response_code();
+  size_t iter = 0;
+  std::string key;
+  std::string value;
+  while (headers_list->EnumerateHeaderLines(&iter, &key, &value)) {
+    key = base::ToLowerASCII(key);
+    (*headers)[key] = value;
+  }
+}
+
+}  // namespace
+
+// Owns the loader of a streamed request and forwards its body, one chunk at a
+// time, to a background sequence.
+class APIRequestHelper::StreamingRequest
+    : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  StreamingRequest(APIRequestHelper* helper,
+                   std::unique_ptr<network::SimpleURLLoader> loader,
+                   DataReceivedCallback data_received_callback,
+                   StreamCompleteCallback callback,
+                   size_t max_body_size)
+      : helper_(helper),
+        loader_(std::move(loader)),
+        task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+            {base::TaskPriority::USER_VISIBLE,
+             base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+        data_received_callback_(std::move(data_received_callback)),
+        callback_(std::move(callback)),
+        max_body_size_(max_body_size) {}
+
+  StreamingRequest(const StreamingRequest&) = delete;
+  StreamingRequest& operator=(const StreamingRequest&) = delete;
+
+  ~StreamingRequest() override = default;
+
+  void Start(network::SharedURLLoaderFactory* url_loader_factory,
+             StreamingRequestList::iterator iter) {
+    iter_ = iter;
+    loader_->DownloadAsStream(url_loader_factory, this);
+  }
+
+  // network::SimpleURLLoaderStreamConsumer:
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override {
+    bytes_received_ += string_piece.size();
+    if (bytes_received_ > max_body_size_) {
+      VLOG(1) << "Streamed response exceeded " << max_body_size_ << " bytes";
+      Complete(false);
+      return;
+    }
+    task_runner_->PostTaskAndReply(
+        FROM_HERE,
+        base::BindOnce(data_received_callback_, std::string(string_piece)),
+        std::move(resume));
+  }
+
+  void OnComplete(bool success) override { Complete(success); }
+
+  void OnRetry(base::OnceClosure start_retry) override {
+    // Chunks that were already handed out cannot be taken back.
+    if (bytes_received_ > 0) {
+      Complete(false);
+      return;
+    }
+    std::move(start_retry).Run();
+  }
+
+ private:
+  void Complete(bool success) {
+    int response_code;
+    base::flat_map<std::string, std::string> headers;
+    GetResponseInfo(loader_.get(), &response_code, &headers);
+    loader_.reset();
+
+    // Chunks still queued on |task_runner_| are handled before |callback_|.
+    task_runner_->PostTaskAndReply(
+        FROM_HERE, base::DoNothing(),
+        base::BindOnce(&StreamingRequest::OnChunksHandled,
+                       weak_ptr_factory_.GetWeakPtr(), response_code, success,
+                       std::move(headers)));
+  }
+
+  void OnChunksHandled(
+      int response_code,
+      bool success,
+      const base::flat_map<std::string, std::string>& headers) {
+    auto callback = std::move(callback_);
+    helper_->OnStreamingRequestComplete(iter_);  // Deletes |this|.
+    std::move(callback).Run(response_code, success, headers);
+  }
+
+  APIRequestHelper* helper_;  // NOT OWNED
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  DataReceivedCallback data_received_callback_;
+  StreamCompleteCallback callback_;
+  const size_t max_body_size_;
+  size_t bytes_received_ = 0;
+  StreamingRequestList::iterator iter_;
+  base::WeakPtrFactory<StreamingRequest> weak_ptr_factory_{this};
+};
+
 APIRequestHelper::APIRequestHelper(
     net::NetworkTrafficAnnotationTag annotation_tag,
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
@@ -25,15 +144,13 @@ APIRequestHelper::APIRequestHelper(
 
 APIRequestHelper::~APIRequestHelper() {}
 
-void APIRequestHelper::Request(
+std::unique_ptr<network::SimpleURLLoader> APIRequestHelper::CreateLoader(
     const std::string& method,
     const GURL& url,
     const std::string& payload,
     const std::string& payload_content_type,
     bool auto_retry_on_network_change,
-    ResultCallback callback,
-    const base::flat_map<std::string, std::string>& headers /* ={} */,
-    size_t max_body_size /* =-1 */) {
+    const base::flat_map<std::string, std::string>& headers) {
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = url;
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE |
@@ -57,7 +174,22 @@ void APIRequestHelper::Request(
           ? network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE
           : network::SimpleURLLoader::RetryMode::RETRY_NEVER);
   url_loader->SetAllowHttpErrorResults(true);
-  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
+  return url_loader;
+}
+
+void APIRequestHelper::Request(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    ResultCallback callback,
+    const base::flat_map<std::string, std::string>& headers /* ={} */,
+    size_t max_body_size /* =-1 */) {
+  auto iter = url_loaders_.insert(
+      url_loaders_.begin(),
+      CreateLoader(method, url, payload, payload_content_type,
+                   auto_retry_on_network_change, headers));
   if (max_body_size == -1u) {
     iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
         url_loader_factory_.get(),
@@ -72,29 +204,124 @@ void APIRequestHelper::Request(
   }
 }
 
+void APIRequestHelper::RequestStreaming(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    DataReceivedCallback data_received_callback,
+    StreamCompleteCallback callback,
+    const base::flat_map<std::string, std::string>& headers,
+    size_t max_body_size) {
+  auto iter = streaming_requests_.insert(
+      streaming_requests_.begin(),
+      std::make_unique<StreamingRequest>(
+          this,
+          CreateLoader(method, url, payload, payload_content_type,
+                       auto_retry_on_network_change, headers),
+          std::move(data_received_callback), std::move(callback),
+          max_body_size));
+  iter->get()->Start(url_loader_factory_.get(), iter);
+}
+
+void APIRequestHelper::RequestJSON(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    ValueResultCallback callback,
+    const base::flat_map<std::string, std::string>& headers,
+    size_t max_body_size,
+    JSONDecodeCaller caller,
+    JSONDecodeMode decode_mode /* =JSONDecodeMode::kThreadPool */) {
+  RequestBody(method, url, payload, payload_content_type,
+              auto_retry_on_network_change,
+              base::BindOnce(&APIRequestHelper::OnJSONBodyReceived,
+                             weak_ptr_factory_.GetWeakPtr(), decode_mode,
+                             caller, std::move(callback)),
+              headers, max_body_size);
+}
+
+void APIRequestHelper::RequestBody(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    BodyCallback callback,
+    const base::flat_map<std::string, std::string>& headers,
+    size_t max_body_size) {
+  // The body is only ever touched on the background sequence, until every
+  // chunk has been appended.
+  auto body = base::MakeRefCounted<base::RefCountedData<std::string>>();
+  RequestStreaming(
+      method, url, payload, payload_content_type, auto_retry_on_network_change,
+      base::BindRepeating(
+          [](scoped_refptr<base::RefCountedData<std::string>> body,
+             std::string chunk) { body->data.append(chunk); },
+          body),
+      base::BindOnce(&APIRequestHelper::OnBodyStreamComplete,
+                     weak_ptr_factory_.GetWeakPtr(), body,
+                     std::move(callback)),
+      headers, max_body_size);
+}
+
 void APIRequestHelper::OnResponse(
     SimpleURLLoaderList::iterator iter,
     ResultCallback callback,
     const std::unique_ptr<std::string> response_body) {
-  auto* loader = iter->get();
-  auto response_code = -1;
+  int response_code;
   base::flat_map<std::string, std::string> headers;
-  if (loader->ResponseInfo()) {
-    auto headers_list = loader->ResponseInfo()->headers;
-    if (headers_list) {
-      response_code = headers_list->response_code();
-      size_t iter = 0;
-      std::string key;
-      std::string value;
-      while (headers_list->EnumerateHeaderLines(&iter, &key, &value)) {
-        key = base::ToLowerASCII(key);
-        headers[key] = value;
-      }
-    }
-  }
+  GetResponseInfo(iter->get(), &response_code, &headers);
   url_loaders_.erase(iter);
   std::move(callback).Run(response_code, response_body ? *response_body : "",
                           headers);
 }
 
+void APIRequestHelper::OnStreamingRequestComplete(
+    StreamingRequestList::iterator iter) {
+  streaming_requests_.erase(iter);
+}
+
+void APIRequestHelper::OnBodyStreamComplete(
+    scoped_refptr<base::RefCountedData<std::string>> body,
+    BodyCallback callback,
+    const int response_code,
+    bool success,
+    const base::flat_map<std::string, std::string>& headers) {
+  if (!success) {
+    std::move(callback).Run(response_code, absl::nullopt, headers);
+    return;
+  }
+  std::move(callback).Run(response_code, std::move(body->data), headers);
+}
+
+void APIRequestHelper::OnJSONBodyReceived(
+    JSONDecodeMode decode_mode,
+    JSONDecodeCaller caller,
+    ValueResultCallback callback,
+    const int response_code,
+    absl::optional<std::string> body,
+    const base::flat_map<std::string, std::string>& headers) {
+  if (!body) {
+    std::move(callback).Run(response_code, absl::nullopt, headers);
+    return;
+  }
+
+  DecodeJSON(std::move(*body), decode_mode, caller,
+             base::BindOnce(&APIRequestHelper::OnJSONParsed,
+                            weak_ptr_factory_.GetWeakPtr(), std::move(callback),
+                            response_code, headers));
+}
+
+void APIRequestHelper::OnJSONParsed(
+    ValueResultCallback callback,
+    const int response_code,
+    const base::flat_map<std::string, std::string>& headers,
+    absl::optional<base::Value> value) {
+  std::move(callback).Run(response_code, std::move(value), headers);
+}
+
 }  // namespace api_request_helper
@@ -9,10 +9,17 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
 
+#include "base/bind.h"
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
+#include "brave/components/api_request_helper/json_decoder.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -43,18 +50,163 @@ class APIRequestHelper {
                const base::flat_map<std::string, std::string>& headers = {},
                size_t max_body_size = -1u);
 
+  using DataReceivedCallback = base::RepeatingCallback<void(std::string)>;
+  // |success| is false if the request failed, was cut short or its body was
+  // larger than allowed.
+  using StreamCompleteCallback =
+      base::OnceCallback<void(const int,
+                              bool success,
+                              const base::flat_map<std::string, std::string>&)>;
+  // Reads the response body as a stream instead of buffering all of it. Each
+  // chunk is passed to |data_received_callback| on a background sequence, and
+  // the next one is not read until it returns, so only one chunk is in memory
+  // at a time. |callback| runs on this sequence once every chunk has been
+  // handled. The request is cancelled as soon as the body grows past
+  // |max_body_size|.
+  void RequestStreaming(
+      const std::string& method,
+      const GURL& url,
+      const std::string& payload,
+      const std::string& payload_content_type,
+      bool auto_retry_on_network_change,
+      DataReceivedCallback data_received_callback,
+      StreamCompleteCallback callback,
+      const base::flat_map<std::string, std::string>& headers,
+      size_t max_body_size);
+
+  using ValueResultCallback =
+      base::OnceCallback<void(const int,
+                              absl::optional<base::Value>,
+                              const base::flat_map<std::string, std::string>&)>;
+  // Downloads a JSON body of at most |max_body_size| bytes and parses it off
+  // this sequence with DecodeJSON(), so large responses are never copied or
+  // parsed on the UI thread. |caller| picks the histograms the decode is
+  // recorded in. |callback| gets absl::nullopt if the request failed or the
+  // body was not valid JSON.
+  void RequestJSON(const std::string& method,
+                   const GURL& url,
+                   const std::string& payload,
+                   const std::string& payload_content_type,
+                   bool auto_retry_on_network_change,
+                   ValueResultCallback callback,
+                   const base::flat_map<std::string, std::string>& headers,
+                   size_t max_body_size,
+                   JSONDecodeCaller caller,
+                   JSONDecodeMode decode_mode = JSONDecodeMode::kThreadPool);
+
+  template <typename T>
+  using TypedResultCallback =
+      base::OnceCallback<void(const int,
+                              absl::optional<T>,
+                              const base::flat_map<std::string, std::string>&)>;
+  // Like RequestJSON(), but also builds a T from the parsed body with
+  // |convert| off this sequence; see DecodeJSONAs().
+  template <typename T>
+  void RequestJSONAs(const std::string& method,
+                     const GURL& url,
+                     const std::string& payload,
+                     const std::string& payload_content_type,
+                     bool auto_retry_on_network_change,
+                     JSONConvertCallback<T> convert,
+                     TypedResultCallback<T> callback,
+                     const base::flat_map<std::string, std::string>& headers,
+                     size_t max_body_size,
+                     JSONDecodeCaller caller,
+                     JSONDecodeMode decode_mode = JSONDecodeMode::kThreadPool) {
+    RequestBody(
+        method, url, payload, payload_content_type,
+        auto_retry_on_network_change,
+        base::BindOnce(&APIRequestHelper::OnJSONAsBodyReceived<T>,
+                       weak_ptr_factory_.GetWeakPtr(), decode_mode, caller,
+                       std::move(convert), std::move(callback)),
+        headers, max_body_size);
+  }
+
  private:
+  class StreamingRequest;
+
   APIRequestHelper(const APIRequestHelper&) = delete;
   APIRequestHelper& operator=(const APIRequestHelper&) = delete;
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
+  using StreamingRequestList = std::list<std::unique_ptr<StreamingRequest>>;
+  std::unique_ptr<network::SimpleURLLoader> CreateLoader(
+      const std::string& method,
+      const GURL& url,
+      const std::string& payload,
+      const std::string& payload_content_type,
+      bool auto_retry_on_network_change,
+      const base::flat_map<std::string, std::string>& headers);
   void OnResponse(SimpleURLLoaderList::iterator iter,
                   ResultCallback callback,
                   const std::unique_ptr<std::string> response_body);
+  void OnStreamingRequestComplete(StreamingRequestList::iterator iter);
+
+  using BodyCallback =
+      base::OnceCallback<void(const int,
+                              absl::optional<std::string>,
+                              const base::flat_map<std::string, std::string>&)>;
+  // Streams the body into a buffer that is only touched off this sequence.
+  // |callback| gets absl::nullopt if the request failed.
+  void RequestBody(const std::string& method,
+                   const GURL& url,
+                   const std::string& payload,
+                   const std::string& payload_content_type,
+                   bool auto_retry_on_network_change,
+                   BodyCallback callback,
+                   const base::flat_map<std::string, std::string>& headers,
+                   size_t max_body_size);
+  void OnBodyStreamComplete(
+      scoped_refptr<base::RefCountedData<std::string>> body,
+      BodyCallback callback,
+      const int response_code,
+      bool success,
+      const base::flat_map<std::string, std::string>& headers);
+  void OnJSONBodyReceived(
+      JSONDecodeMode decode_mode,
+      JSONDecodeCaller caller,
+      ValueResultCallback callback,
+      const int response_code,
+      absl::optional<std::string> body,
+      const base::flat_map<std::string, std::string>& headers);
+  void OnJSONParsed(ValueResultCallback callback,
+                    const int response_code,
+                    const base::flat_map<std::string, std::string>& headers,
+                    absl::optional<base::Value> value);
+
+  template <typename T>
+  void OnJSONAsBodyReceived(
+      JSONDecodeMode decode_mode,
+      JSONDecodeCaller caller,
+      JSONConvertCallback<T> convert,
+      TypedResultCallback<T> callback,
+      const int response_code,
+      absl::optional<std::string> body,
+      const base::flat_map<std::string, std::string>& headers) {
+    if (!body) {
+      std::move(callback).Run(response_code, absl::nullopt, headers);
+      return;
+    }
+    DecodeJSONAs<T>(
+        std::move(*body), decode_mode, caller, std::move(convert),
+        base::BindOnce(&APIRequestHelper::OnJSONAsDecoded<T>,
+                       weak_ptr_factory_.GetWeakPtr(), std::move(callback),
+                       response_code, headers));
+  }
+
+  template <typename T>
+  void OnJSONAsDecoded(TypedResultCallback<T> callback,
+                       const int response_code,
+                       const base::flat_map<std::string, std::string>& headers,
+                       absl::optional<T> result) {
+    std::move(callback).Run(response_code, std::move(result), headers);
+  }
 
   net::NetworkTrafficAnnotationTag annotation_tag_;
   SimpleURLLoaderList url_loaders_;
+  StreamingRequestList streaming_requests_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  base::WeakPtrFactory<APIRequestHelper> weak_ptr_factory_{this};
 };
 
 }  // namespace api_request_helper
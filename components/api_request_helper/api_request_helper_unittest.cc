@@ -0,0 +1,140 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/api_request_helper/api_request_helper.h"
+
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace api_request_helper {
+
+class ApiRequestHelperUnitTest : public testing::Test {
+ public:
+  ApiRequestHelperUnitTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        api_request_helper_(TRAFFIC_ANNOTATION_FOR_TESTS,
+                            shared_url_loader_factory_) {}
+
+  void SetResponse(const std::string& body) {
+    url_loader_factory_.AddResponse(url_.spec(), body);
+  }
+
+  absl::optional<base::Value> RequestJSON(size_t max_body_size) {
+    absl::optional<base::Value> result;
+    base::RunLoop run_loop;
+    api_request_helper_.RequestJSON(
+        "GET", url_, "", "", true,
+        base::BindLambdaForTesting(
+            [&](const int status, absl::optional<base::Value> value,
+                const base::flat_map<std::string, std::string>& headers) {
+              EXPECT_EQ(status, 200);
+              result = std::move(value);
+              run_loop.Quit();
+            }),
+        {}, max_body_size, JSONDecodeCaller::kOther);
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  const GURL url_{"https://example.com/feed.json"};
+  base::test::TaskEnvironment task_environment_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  APIRequestHelper api_request_helper_;
+};
+
+TEST_F(ApiRequestHelperUnitTest, RequestStreaming) {
+  const std::string body(64 * 1024, 'a');
+  SetResponse(body);
+
+  // Chunks arrive on a background sequence.
+  auto received = base::MakeRefCounted<base::RefCountedData<std::string>>();
+  base::RunLoop run_loop;
+  api_request_helper_.RequestStreaming(
+      "GET", url_, "", "", true,
+      base::BindRepeating(
+          [](scoped_refptr<base::RefCountedData<std::string>> received,
+             std::string chunk) { received->data.append(chunk); },
+          received),
+      base::BindLambdaForTesting(
+          [&](const int status, bool success,
+              const base::flat_map<std::string, std::string>& headers) {
+            EXPECT_EQ(status, 200);
+            EXPECT_TRUE(success);
+            run_loop.Quit();
+          }),
+      {}, body.size());
+  run_loop.Run();
+
+  EXPECT_EQ(received->data, body);
+}
+
+TEST_F(ApiRequestHelperUnitTest, RequestStreamingTooLarge) {
+  SetResponse(std::string(1024, 'a'));
+
+  base::RunLoop run_loop;
+  api_request_helper_.RequestStreaming(
+      "GET", url_, "", "", true, base::BindRepeating([](std::string chunk) {}),
+      base::BindLambdaForTesting(
+          [&](const int status, bool success,
+              const base::flat_map<std::string, std::string>& headers) {
+            EXPECT_FALSE(success);
+            run_loop.Quit();
+          }),
+      {}, 1023);
+  run_loop.Run();
+}
+
+TEST_F(ApiRequestHelperUnitTest, RequestJSON) {
+  SetResponse(R"([{"title": "Hello"}, {"title": "World"}])");
+  absl::optional<base::Value> value = RequestJSON(1024);
+  ASSERT_TRUE(value);
+  ASSERT_TRUE(value->is_list());
+  EXPECT_EQ(value->GetList().size(), 2u);
+
+  SetResponse("Answer is 42");
+  EXPECT_FALSE(RequestJSON(1024));
+
+  SetResponse(R"([{"title": "Hello"}, {"title": "World"}])");
+  EXPECT_FALSE(RequestJSON(16));
+}
+
+TEST_F(ApiRequestHelperUnitTest, RequestJSONAs) {
+  SetResponse(R"([{"title": "Hello"}, {"title": "World"}])");
+
+  absl::optional<size_t> result;
+  base::RunLoop run_loop;
+  api_request_helper_.RequestJSONAs<size_t>(
+      "GET", url_, "", "", true,
+      base::BindOnce([](base::Value value) -> absl::optional<size_t> {
+        if (!value.is_list())
+          return absl::nullopt;
+        return value.GetList().size();
+      }),
+      base::BindLambdaForTesting(
+          [&](const int status, absl::optional<size_t> size,
+              const base::flat_map<std::string, std::string>& headers) {
+            EXPECT_EQ(status, 200);
+            result = size;
+            run_loop.Quit();
+          }),
+      {}, 1024, JSONDecodeCaller::kOther);
+  run_loop.Run();
+
+  EXPECT_EQ(result, 2u);
+}
+
+}  // namespace api_request_helper
@@ -0,0 +1,109 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/api_request_helper/json_decoder.h"
+
+#include <string>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/notreached.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "services/data_decoder/public/cpp/data_decoder.h"
+
+namespace api_request_helper {
+
+namespace {
+
+const char kDecodeTimeHistogramPrefix[] =
+    "Brave.APIRequestHelper.JSONDecodeTime.";
+const char kPayloadSizeHistogramPrefix[] =
+    "Brave.APIRequestHelper.JSONPayloadSize.";
+
+// Must match the Caller variants in histograms.xml.
+const char* GetCallerHistogramSuffix(JSONDecodeCaller caller) {
+  switch (caller) {
+    case JSONDecodeCaller::kOther:
+      return "Other";
+    case JSONDecodeCaller::kBraveNewsFeed:
+      return "BraveNews.Feed";
+    case JSONDecodeCaller::kBraveNewsPublishers:
+      return "BraveNews.Publishers";
+    case JSONDecodeCaller::kWalletAssetRatio:
+      return "Wallet.AssetRatio";
+    case JSONDecodeCaller::kWalletSwap:
+      return "Wallet.Swap";
+  }
+  NOTREACHED();
+  return "Other";
+}
+
+void RecordDecodeTime(JSONDecodeCaller caller, base::TimeDelta elapsed) {
+  base::UmaHistogramTimes(
+      std::string(kDecodeTimeHistogramPrefix) +
+          GetCallerHistogramSuffix(caller),
+      elapsed);
+}
+
+void OnDataDecoderParsed(JSONDecodeCaller caller,
+                         base::TimeTicks start_time,
+                         JSONDecodeCallback callback,
+                         data_decoder::DataDecoder::ValueOrError result) {
+  // Includes the round trip to the service, which is what the caller waits
+  // for.
+  RecordDecodeTime(caller, base::TimeTicks::Now() - start_time);
+  if (!result.value) {
+    VLOG(1) << "Could not parse JSON: " << result.error.value_or("");
+  }
+  std::move(callback).Run(std::move(result.value));
+}
+
+}  // namespace
+
+namespace internal {
+
+void RecordPayloadSize(size_t size, JSONDecodeCaller caller) {
+  base::UmaHistogramMemoryKB(std::string(kPayloadSizeHistogramPrefix) +
+                                 GetCallerHistogramSuffix(caller),
+                             size / 1024);
+}
+
+absl::optional<base::Value> ParseJSON(const std::string& json,
+                                      JSONDecodeCaller caller) {
+  base::ElapsedTimer timer;
+  absl::optional<base::Value> value =
+      base::JSONReader::Read(json, base::JSON_PARSE_RFC);
+  RecordDecodeTime(caller, timer.Elapsed());
+  return value;
+}
+
+}  // namespace internal
+
+void DecodeJSON(std::string json,
+                JSONDecodeMode mode,
+                JSONDecodeCaller caller,
+                JSONDecodeCallback callback) {
+  internal::RecordPayloadSize(json.size(), caller);
+
+  switch (mode) {
+    case JSONDecodeMode::kThreadPool:
+      base::ThreadPool::PostTaskAndReplyWithResult(
+          FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+          base::BindOnce(&internal::ParseJSON, std::move(json), caller),
+          std::move(callback));
+      return;
+    case JSONDecodeMode::kDataDecoder:
+      data_decoder::DataDecoder::ParseJsonIsolated(
+          json, base::BindOnce(&OnDataDecoderParsed, caller,
+                               base::TimeTicks::Now(), std::move(callback)));
+      return;
+  }
+  NOTREACHED();
+}
+
+}  // namespace api_request_helper
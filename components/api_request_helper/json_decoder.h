@@ -0,0 +1,122 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_API_REQUEST_HELPER_JSON_DECODER_H_
+#define BRAVE_COMPONENTS_API_REQUEST_HELPER_JSON_DECODER_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/location.h"
+#include "base/task/thread_pool.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace api_request_helper {
+
+enum class JSONDecodeMode {
+  // Parses in the browser process on the thread pool. Fine for responses
+  // from Brave's own services.
+  kThreadPool,
+  // Parses in the data_decoder service, which is sandboxed out of process on
+  // platforms that support it. Use for responses from third parties.
+  kDataDecoder,
+};
+
+// Who a payload is decoded for. Used as a fixed suffix on the histograms
+// below so they show which endpoints dominate decode time; add a value here,
+// to GetCallerHistogramSuffix() and to the Caller variants in histograms.xml
+// for each new consumer.
+enum class JSONDecodeCaller {
+  kOther,
+  kBraveNewsFeed,
+  kBraveNewsPublishers,
+  kWalletAssetRatio,
+  kWalletSwap,
+};
+
+using JSONDecodeCallback =
+    base::OnceCallback<void(absl::optional<base::Value>)>;
+
+// Parses |json| off the calling sequence and runs |callback| on it with the
+// result, or absl::nullopt if |json| is not valid JSON. The payload size and
+// time spent parsing are recorded in the
+// Brave.APIRequestHelper.JSONPayloadSize.<caller> and
+// Brave.APIRequestHelper.JSONDecodeTime.<caller> histograms.
+void DecodeJSON(std::string json,
+                JSONDecodeMode mode,
+                JSONDecodeCaller caller,
+                JSONDecodeCallback callback);
+
+template <typename T>
+using JSONConvertCallback = base::OnceCallback<absl::optional<T>(base::Value)>;
+
+template <typename T>
+using TypedJSONDecodeCallback = base::OnceCallback<void(absl::optional<T>)>;
+
+namespace internal {
+
+void RecordPayloadSize(size_t size, JSONDecodeCaller caller);
+
+// Must be called on the thread pool.
+absl::optional<base::Value> ParseJSON(const std::string& json,
+                                      JSONDecodeCaller caller);
+
+}  // namespace internal
+
+// Like DecodeJSON(), but also turns the parsed value into a T with |convert|
+// on the thread pool, so that neither step runs on the calling sequence.
+// With kThreadPool both steps run in the same task. |convert| must not touch
+// state owned by the caller. |callback| gets absl::nullopt if |json| is not
+// valid JSON or |convert| failed.
+template <typename T>
+void DecodeJSONAs(std::string json,
+                  JSONDecodeMode mode,
+                  JSONDecodeCaller caller,
+                  JSONConvertCallback<T> convert,
+                  TypedJSONDecodeCallback<T> callback) {
+  if (mode == JSONDecodeMode::kThreadPool) {
+    internal::RecordPayloadSize(json.size(), caller);
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(
+            [](const std::string& json, JSONDecodeCaller caller,
+               JSONConvertCallback<T> convert) -> absl::optional<T> {
+              absl::optional<base::Value> value =
+                  internal::ParseJSON(json, caller);
+              if (!value)
+                return absl::nullopt;
+              return std::move(convert).Run(std::move(*value));
+            },
+            std::move(json), caller, std::move(convert)),
+        std::move(callback));
+    return;
+  }
+
+  DecodeJSON(
+      std::move(json), mode, caller,
+      base::BindOnce(
+          [](JSONConvertCallback<T> convert,
+             TypedJSONDecodeCallback<T> callback,
+             absl::optional<base::Value> value) {
+            if (!value) {
+              std::move(callback).Run(absl::nullopt);
+              return;
+            }
+            base::ThreadPool::PostTaskAndReplyWithResult(
+                FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+                base::BindOnce(std::move(convert), std::move(*value)),
+                std::move(callback));
+          },
+          std::move(convert), std::move(callback)));
+}
+
+}  // namespace api_request_helper
+
+#endif  // BRAVE_COMPONENTS_API_REQUEST_HELPER_JSON_DECODER_H_
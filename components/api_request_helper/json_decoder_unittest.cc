@@ -0,0 +1,112 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/api_request_helper/json_decoder.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace api_request_helper {
+
+namespace {
+
+absl::optional<std::vector<std::string>> GetTitles(base::Value value) {
+  if (!value.is_list())
+    return absl::nullopt;
+  std::vector<std::string> titles;
+  for (const auto& item : value.GetList()) {
+    const std::string* title = item.FindStringKey("title");
+    if (!title)
+      return absl::nullopt;
+    titles.push_back(*title);
+  }
+  return titles;
+}
+
+}  // namespace
+
+class JSONDecoderUnitTest : public testing::TestWithParam<JSONDecodeMode> {
+ public:
+  absl::optional<base::Value> Decode(
+      const std::string& json,
+      JSONDecodeCaller caller = JSONDecodeCaller::kOther) {
+    absl::optional<base::Value> result;
+    base::RunLoop run_loop;
+    DecodeJSON(json, GetParam(), caller,
+               base::BindLambdaForTesting(
+                   [&](absl::optional<base::Value> value) {
+                     result = std::move(value);
+                     run_loop.Quit();
+                   }));
+    run_loop.Run();
+    return result;
+  }
+
+  absl::optional<std::vector<std::string>> DecodeTitles(
+      const std::string& json) {
+    absl::optional<std::vector<std::string>> result;
+    base::RunLoop run_loop;
+    DecodeJSONAs<std::vector<std::string>>(
+        json, GetParam(), JSONDecodeCaller::kOther, base::BindOnce(&GetTitles),
+        base::BindLambdaForTesting(
+            [&](absl::optional<std::vector<std::string>> titles) {
+              result = std::move(titles);
+              run_loop.Quit();
+            }));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
+};
+
+TEST_P(JSONDecoderUnitTest, DecodeJSON) {
+  base::HistogramTester histogram_tester;
+
+  absl::optional<base::Value> value = Decode(R"({"answer": 42})");
+  ASSERT_TRUE(value);
+  EXPECT_EQ(value->FindIntKey("answer"), 42);
+
+  EXPECT_FALSE(Decode("Answer is 42"));
+  EXPECT_TRUE(Decode("[]", JSONDecodeCaller::kWalletSwap));
+
+  // Each caller is recorded under its own suffix.
+  histogram_tester.ExpectTotalCount(
+      "Brave.APIRequestHelper.JSONDecodeTime.Other", 2);
+  histogram_tester.ExpectTotalCount(
+      "Brave.APIRequestHelper.JSONPayloadSize.Other", 2);
+  histogram_tester.ExpectTotalCount(
+      "Brave.APIRequestHelper.JSONDecodeTime.Wallet.Swap", 1);
+  histogram_tester.ExpectTotalCount(
+      "Brave.APIRequestHelper.JSONPayloadSize.Wallet.Swap", 1);
+}
+
+TEST_P(JSONDecoderUnitTest, DecodeJSONAs) {
+  absl::optional<std::vector<std::string>> titles =
+      DecodeTitles(R"([{"title": "Hello"}, {"title": "World"}])");
+  ASSERT_TRUE(titles);
+  EXPECT_EQ(*titles, std::vector<std::string>({"Hello", "World"}));
+
+  // Invalid JSON and values |convert| rejects both give absl::nullopt.
+  EXPECT_FALSE(DecodeTitles("Answer is 42"));
+  EXPECT_FALSE(DecodeTitles(R"([{"name": "Hello"}])"));
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         JSONDecoderUnitTest,
+                         testing::Values(JSONDecodeMode::kThreadPool,
+                                         JSONDecodeMode::kDataDecoder));
+
+}  // namespace api_request_helper
@@ -38,13 +38,8 @@ void AdBlockDefaultFiltersProvider::OnComponentReady(
     const base::FilePath& path) {
   component_path_ = path;
 
-  // Load the DAT (as a buffer)
-  base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::ReadDATFileData,
-                     component_path_.AppendASCII(DAT_FILE)),
-      base::BindOnce(&AdBlockDefaultFiltersProvider::OnDATLoaded,
-                     weak_factory_.GetWeakPtr(), true));
+  // The DAT is mapped directly by the engine
+  OnSerializedDATFileReady(GetSerializedDATFilePath());
 
   // Load the resources (as a string)
   base::ThreadPool::PostTaskAndReplyWithResult(
@@ -79,6 +74,14 @@ void AdBlockDefaultFiltersProvider::LoadDATBuffer(
       base::BindOnce(std::move(cb), true));
 }
 
+base::FilePath AdBlockDefaultFiltersProvider::GetSerializedDATFilePath()
+    const {
+  if (component_path_.empty())
+    return base::FilePath();
+
+  return component_path_.AppendASCII(DAT_FILE);
+}
+
 void AdBlockDefaultFiltersProvider::LoadResources(
     base::OnceCallback<void(const std::string& resources_json)> cb) {
   if (component_path_.empty()) {
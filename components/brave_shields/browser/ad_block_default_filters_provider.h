@@ -55,6 +55,9 @@ class AdBlockDefaultFiltersProvider : public AdBlockFiltersProvider,
   friend class ::AdBlockServiceTest;
   void OnComponentReady(const base::FilePath&);
 
+  // AdBlockFiltersProvider
+  base::FilePath GetSerializedDATFilePath() const override;
+
   base::FilePath component_path_;
 
   base::WeakPtrFactory<AdBlockDefaultFiltersProvider> weak_factory_{this};
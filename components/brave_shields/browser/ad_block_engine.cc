@@ -13,7 +13,9 @@
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_reader.h"
+#include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
@@ -97,6 +99,12 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
 
 namespace brave_shields {
 
+AdBlockEngineSnapshot::AdBlockEngineSnapshot(
+    std::vector<std::shared_ptr<AdBlockEngine>> engines)
+    : engines_(std::move(engines)) {}
+
+AdBlockEngineSnapshot::~AdBlockEngineSnapshot() = default;
+
 AdBlockEngine::AdBlockEngine() : ad_block_client_(new adblock::Engine()) {}
 
 AdBlockEngine::~AdBlockEngine() {}
@@ -127,6 +135,22 @@ void AdBlockEngine::ShouldStartRequest(const GURL& url,
   //  << ", url.spec(): " << url.spec();
 }
 
+void AdBlockEngine::ShouldStartRequests(
+    base::span<const AdBlockMatchRequest> requests,
+    base::span<AdBlockMatchResult> results) {
+  DCHECK_EQ(requests.size(), results.size());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    AdBlockMatchResult& result = results[i];
+    if (result.did_match_important)
+      continue;
+    const AdBlockMatchRequest& request = requests[i];
+    ShouldStartRequest(request.url, request.resource_type, request.tab_host,
+                       request.aggressive_blocking, &result.did_match_rule,
+                       &result.did_match_exception,
+                       &result.did_match_important, &result.mock_data_url);
+  }
+}
+
 absl::optional<std::string> AdBlockEngine::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -195,18 +219,68 @@ base::Value AdBlockEngine::HiddenClassIdSelectors(
 void AdBlockEngine::Load(bool deserialize,
                          const DATFileDataBuffer& dat_buf,
                          const std::string& resources_json) {
+  UpdateAdBlockClient(CreateClient(deserialize, dat_buf, resources_json));
+}
+
+void AdBlockEngine::LoadFromFile(const base::FilePath& dat_file_path,
+                                 const std::string& resources_json) {
+  UpdateAdBlockClient(CreateClientFromFile(dat_file_path, resources_json));
+}
+
+// static
+std::unique_ptr<adblock::Engine> AdBlockEngine::CreateClient(
+    bool deserialize,
+    const DATFileDataBuffer& dat_buf,
+    const std::string& resources_json) {
+  std::unique_ptr<adblock::Engine> client;
   if (deserialize) {
-    OnDATLoaded(dat_buf, resources_json);
+    // An empty buffer will not load successfully.
+    if (dat_buf.empty()) {
+      return nullptr;
+    }
+    client = std::make_unique<adblock::Engine>();
+    if (!client->deserialize(reinterpret_cast<const char*>(&dat_buf.front()),
+                             dat_buf.size())) {
+      return nullptr;
+    }
   } else {
-    OnListSourceLoaded(dat_buf, resources_json);
+    client = std::make_unique<adblock::Engine>(
+        reinterpret_cast<const char*>(dat_buf.data()), dat_buf.size());
   }
+
+  client->addResources(resources_json);
+  return client;
 }
 
-void AdBlockEngine::UpdateAdBlockClient(
-    std::unique_ptr<adblock::Engine> ad_block_client,
+// static
+std::unique_ptr<adblock::Engine> AdBlockEngine::CreateClientFromFile(
+    const base::FilePath& dat_file_path,
     const std::string& resources_json) {
+  // The mapping only needs to live for the duration of the deserialization,
+  // the pages are shared through the page cache in the meantime.
+  base::MemoryMappedFile dat_file;
+  if (!dat_file.Initialize(dat_file_path) || dat_file.length() == 0) {
+    LOG(ERROR) << "AdBlockEngine: cannot map dat file " << dat_file_path;
+    return nullptr;
+  }
+
+  auto client = std::make_unique<adblock::Engine>();
+  if (!client->deserialize(reinterpret_cast<const char*>(dat_file.data()),
+                           dat_file.length())) {
+    return nullptr;
+  }
+
+  client->addResources(resources_json);
+  return client;
+}
+
+void AdBlockEngine::UpdateAdBlockClient(
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  if (!ad_block_client) {
+    return;
+  }
+
   ad_block_client_ = std::move(ad_block_client);
-  AddResources(resources_json);
   AddKnownTagsToAdBlockInstance();
   if (test_observer_) {
     test_observer_->OnEngineUpdated();
@@ -218,28 +292,6 @@ void AdBlockEngine::AddKnownTagsToAdBlockInstance() {
                 [&](const std::string tag) { ad_block_client_->addTag(tag); });
 }
 
-void AdBlockEngine::OnListSourceLoaded(const DATFileDataBuffer& filters,
-                                       const std::string& resources_json) {
-  UpdateAdBlockClient(
-      std::make_unique<adblock::Engine>(
-          reinterpret_cast<const char*>(filters.data()), filters.size()),
-      resources_json);
-}
-
-void AdBlockEngine::OnDATLoaded(const DATFileDataBuffer& dat_buf,
-                                const std::string& resources_json) {
-  // An empty buffer will not load successfully.
-  if (dat_buf.empty()) {
-    return;
-  }
-
-  auto client = std::make_unique<adblock::Engine>();
-  client->deserialize(reinterpret_cast<const char*>(&dat_buf.front()),
-                      dat_buf.size());
-
-  UpdateAdBlockClient(std::move(client), resources_json);
-}
-
 void AdBlockEngine::AddObserverForTest(AdBlockEngine::TestObserver* observer) {
   test_observer_ = observer;
 }
@@ -14,6 +14,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_types.h"
 #include "base/values.h"
@@ -34,6 +37,48 @@ class PerfPredictorTabHelperTest;
 
 namespace brave_shields {
 
+class AdBlockEngine;
+
+// An immutable snapshot of a set of engines. Managers publish a new snapshot
+// whenever their set of engines changes, and readers hold on to the snapshot
+// they loaded for as long as they are matching, which also keeps the engines
+// in it alive.
+class AdBlockEngineSnapshot
+    : public base::RefCountedThreadSafe<AdBlockEngineSnapshot> {
+ public:
+  explicit AdBlockEngineSnapshot(
+      std::vector<std::shared_ptr<AdBlockEngine>> engines);
+  AdBlockEngineSnapshot(const AdBlockEngineSnapshot&) = delete;
+  AdBlockEngineSnapshot& operator=(const AdBlockEngineSnapshot&) = delete;
+
+  const std::vector<std::shared_ptr<AdBlockEngine>>& engines() const {
+    return engines_;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockEngineSnapshot>;
+  ~AdBlockEngineSnapshot();
+
+  const std::vector<std::shared_ptr<AdBlockEngine>> engines_;
+};
+
+// A single network request to be checked by ShouldStartRequests.
+struct AdBlockMatchRequest {
+  GURL url;
+  blink::mojom::ResourceType resource_type;
+  std::string tab_host;
+  bool aggressive_blocking = false;
+};
+
+// The result of checking an AdBlockMatchRequest. Results are accumulated
+// across engines, so they are used both as inputs and outputs.
+struct AdBlockMatchResult {
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string mock_data_url;
+};
+
 // Service managing an adblock engine.
 class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
  public:
@@ -53,6 +98,11 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  // Checks every request in |requests|, updating the result at the same index
+  // in |results|. Requests that already matched an important rule are
+  // skipped.
+  void ShouldStartRequests(base::span<const AdBlockMatchRequest> requests,
+                           base::span<AdBlockMatchResult> results);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -70,6 +120,26 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
   void Load(bool deserialize,
             const DATFileDataBuffer& dat_buf,
             const std::string& resources_json);
+  // Maps a serialized engine file and deserializes it in place, avoiding an
+  // intermediate heap copy of the file contents. Must be called on a sequence
+  // that allows blocking.
+  void LoadFromFile(const base::FilePath& dat_file_path,
+                    const std::string& resources_json);
+
+  // Build a new adblock client with |resources_json| already added. These can
+  // run on any thread that allows blocking, so that compiling or deserializing
+  // a list doesn't hold up matching on the adblock task runner. They return
+  // nullptr if the existing client should be kept.
+  static std::unique_ptr<adblock::Engine> CreateClient(
+      bool deserialize,
+      const DATFileDataBuffer& dat_buf,
+      const std::string& resources_json);
+  static std::unique_ptr<adblock::Engine> CreateClientFromFile(
+      const base::FilePath& dat_file_path,
+      const std::string& resources_json);
+
+  // Swaps in a client built by one of the functions above.
+  void UpdateAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client);
 
   class TestObserver : public base::CheckedObserver {
    public:
@@ -81,13 +151,6 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
 
  protected:
   void AddKnownTagsToAdBlockInstance();
-  void UpdateAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client,
-                           const std::string& resources_json);
-  void OnListSourceLoaded(const DATFileDataBuffer& filters,
-                          const std::string& resources_json);
-
-  void OnDATLoaded(const DATFileDataBuffer& dat_buf,
-                   const std::string& resources_json);
 
   std::unique_ptr<adblock::Engine> ad_block_client_;
 
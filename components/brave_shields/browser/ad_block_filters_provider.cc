@@ -5,6 +5,9 @@
 
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
 
+#include "base/bind.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+
 namespace brave_shields {
 
 AdBlockFiltersProvider::AdBlockFiltersProvider() {}
@@ -30,8 +33,25 @@ void AdBlockFiltersProvider::OnDATLoaded(bool deserialize,
   }
 }
 
+void AdBlockFiltersProvider::OnSerializedDATFileReady(
+    const base::FilePath& dat_file_path) {
+  for (auto& observer : observers_) {
+    observer.OnSerializedDATFileReady(dat_file_path);
+  }
+}
+
 void AdBlockFiltersProvider::LoadDAT(
     AdBlockFiltersProvider::Observer* observer) {
+  const base::FilePath dat_file_path = GetSerializedDATFilePath();
+  if (!dat_file_path.empty()) {
+    // PostTask so this has an async return to match the buffer loaders
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&AdBlockFiltersProvider::OnFileReady,
+                       weak_factory_.GetWeakPtr(), observer, dat_file_path));
+    return;
+  }
+
   LoadDATBuffer(base::BindOnce(&AdBlockFiltersProvider::OnLoad,
                                weak_factory_.GetWeakPtr(), observer));
 }
@@ -44,6 +64,18 @@ void AdBlockFiltersProvider::OnLoad(AdBlockFiltersProvider::Observer* observer,
   }
 }
 
+void AdBlockFiltersProvider::OnFileReady(
+    AdBlockFiltersProvider::Observer* observer,
+    const base::FilePath& dat_file_path) {
+  if (observers_.HasObserver(observer)) {
+    observer->OnSerializedDATFileReady(dat_file_path);
+  }
+}
+
+base::FilePath AdBlockFiltersProvider::GetSerializedDATFilePath() const {
+  return base::FilePath();
+}
+
 bool AdBlockFiltersProvider::Delete() && {
   return false;
 }
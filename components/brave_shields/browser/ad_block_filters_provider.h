@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FILTERS_PROVIDER_H_
 
 #include "base/callback.h"
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
@@ -24,6 +25,11 @@ class AdBlockFiltersProvider {
    public:
     virtual void OnDATLoaded(bool deserialize,
                              const DATFileDataBuffer& dat_buf) = 0;
+    // Called instead of OnDATLoaded when the provider's data is a serialized
+    // engine on disk, so that it can be mapped straight into the engine
+    // without first being copied onto the heap.
+    virtual void OnSerializedDATFileReady(const base::FilePath& dat_file_path) {
+    }
   };
 
   AdBlockFiltersProvider();
@@ -39,6 +45,10 @@ class AdBlockFiltersProvider {
   virtual bool Delete() &&;
 
  protected:
+  // Returns the path of the serialized DAT file backing this provider, or an
+  // empty path if the data has to be loaded through LoadDATBuffer.
+  virtual base::FilePath GetSerializedDATFilePath() const;
+
   virtual void LoadDATBuffer(
       base::OnceCallback<void(bool deserialize,
                               const DATFileDataBuffer& dat_buf)>) = 0;
@@ -46,7 +56,10 @@ class AdBlockFiltersProvider {
   void OnLoad(AdBlockFiltersProvider::Observer* observer,
               bool deserialize,
               const DATFileDataBuffer& dat_buf);
+  void OnFileReady(AdBlockFiltersProvider::Observer* observer,
+                   const base::FilePath& dat_file_path);
   void OnDATLoaded(bool deserialize, const DATFileDataBuffer& dat_buf);
+  void OnSerializedDATFileReady(const base::FilePath& dat_file_path);
 
  private:
   base::ObserverList<Observer> observers_;
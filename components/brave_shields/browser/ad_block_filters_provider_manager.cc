@@ -0,0 +1,192 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_filters_provider_manager.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/contains.h"
+#include "base/logging.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+
+namespace brave_shields {
+
+namespace {
+
+// How long to wait for further provider updates before rebuilding the
+// combined filter list.
+constexpr base::TimeDelta kRebuildDelay = base::Seconds(1);
+
+}  // namespace
+
+AdBlockFiltersProviderManager::ProviderObserver::ProviderObserver(
+    AdBlockFiltersProviderManager* manager,
+    AdBlockFiltersProvider* provider,
+    base::OnceClosure on_not_mergeable)
+    : manager_(manager),
+      provider_(provider),
+      on_not_mergeable_(std::move(on_not_mergeable)) {
+  provider_->AddObserver(this);
+  provider_->LoadDAT(this);
+}
+
+AdBlockFiltersProviderManager::ProviderObserver::~ProviderObserver() {
+  provider_->RemoveObserver(this);
+}
+
+void AdBlockFiltersProviderManager::ProviderObserver::OnDATLoaded(
+    bool deserialize,
+    const DATFileDataBuffer& dat_buf) {
+  manager_->OnProviderDATLoaded(provider_, deserialize, dat_buf);
+}
+
+void AdBlockFiltersProviderManager::ProviderObserver::OnSerializedDATFileReady(
+    const base::FilePath& dat_file_path) {
+  manager_->OnProviderNotMergeable(provider_);
+}
+
+base::OnceClosure
+AdBlockFiltersProviderManager::ProviderObserver::TakeNotMergeableCallback() {
+  return std::move(on_not_mergeable_);
+}
+
+AdBlockFiltersProviderManager::AdBlockFiltersProviderManager()
+    : rebuild_delay_(kRebuildDelay) {}
+
+AdBlockFiltersProviderManager::~AdBlockFiltersProviderManager() {}
+
+void AdBlockFiltersProviderManager::AddProvider(
+    AdBlockFiltersProvider* provider,
+    base::OnceClosure on_not_mergeable) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(provider);
+  if (HasProvider(provider))
+    return;
+  provider_observers_.insert(
+      {provider, std::make_unique<ProviderObserver>(
+                     this, provider, std::move(on_not_mergeable))});
+}
+
+void AdBlockFiltersProviderManager::RemoveProvider(
+    AdBlockFiltersProvider* provider) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!HasProvider(provider))
+    return;
+  provider_observers_.erase(provider);
+  if (provider_filters_.erase(provider))
+    ScheduleRebuild();
+}
+
+void AdBlockFiltersProviderManager::ReloadProvider(
+    AdBlockFiltersProvider* provider) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = provider_observers_.find(provider);
+  if (it == provider_observers_.end())
+    return;
+  provider->LoadDAT(it->second.get());
+}
+
+bool AdBlockFiltersProviderManager::HasProvider(
+    AdBlockFiltersProvider* provider) const {
+  return base::Contains(provider_observers_, provider);
+}
+
+void AdBlockFiltersProviderManager::LoadDATBuffer(
+    base::OnceCallback<void(bool deserialize, const DATFileDataBuffer& dat_buf)>
+        cb) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (provider_filters_.empty()) {
+    // Nothing has been loaded yet, don't run the callback. The combined list
+    // will be pushed to observers once the first provider is ready.
+    return;
+  }
+
+  std::move(cb).Run(false, GetCombinedFilters());
+}
+
+void AdBlockFiltersProviderManager::OnProviderDATLoaded(
+    AdBlockFiltersProvider* provider,
+    bool deserialize,
+    const DATFileDataBuffer& dat_buf) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (deserialize) {
+    OnProviderNotMergeable(provider);
+    return;
+  }
+
+  provider_filters_[provider] = dat_buf;
+  ScheduleRebuild();
+}
+
+void AdBlockFiltersProviderManager::OnProviderNotMergeable(
+    AdBlockFiltersProvider* provider) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Serialized engines can't be combined with each other, only list text
+  // can be.
+  auto it = provider_observers_.find(provider);
+  if (it == provider_observers_.end())
+    return;
+  VLOG(1) << "Adblock filters can't be merged, falling back to a separate "
+             "engine";
+  // This is called by the provider's observer, which can't be destroyed
+  // until it has returned.
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockFiltersProviderManager::RemoveNotMergeableProvider,
+                     weak_factory_.GetWeakPtr(), provider,
+                     it->second->TakeNotMergeableCallback()));
+}
+
+void AdBlockFiltersProviderManager::RemoveNotMergeableProvider(
+    AdBlockFiltersProvider* provider,
+    base::OnceClosure on_not_mergeable) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!HasProvider(provider))
+    return;
+  RemoveProvider(provider);
+  if (on_not_mergeable)
+    std::move(on_not_mergeable).Run();
+}
+
+void AdBlockFiltersProviderManager::ScheduleRebuild() {
+  rebuild_timer_.Start(
+      FROM_HERE, rebuild_delay_,
+      base::BindOnce(
+          &AdBlockFiltersProviderManager::NotifyCombinedFiltersChanged,
+          base::Unretained(this)));
+}
+
+void AdBlockFiltersProviderManager::NotifyCombinedFiltersChanged() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // The observing engine compiles the combined list on its own task runner.
+  OnDATLoaded(false, GetCombinedFilters());
+}
+
+DATFileDataBuffer AdBlockFiltersProviderManager::GetCombinedFilters() const {
+  size_t size = 0;
+  for (const auto& filters : provider_filters_) {
+    size += filters.second.size() + 1;
+  }
+
+  DATFileDataBuffer combined;
+  combined.reserve(size);
+  for (const auto& filters : provider_filters_) {
+    combined.insert(combined.end(), filters.second.begin(),
+                    filters.second.end());
+    // Lists don't necessarily end with a newline, make sure the last rule of
+    // one list doesn't get joined with the first rule of the next.
+    combined.push_back('\n');
+  }
+
+  return combined;
+}
+
+void AdBlockFiltersProviderManager::SetRebuildDelayForTest(
+    base::TimeDelta delay) {
+  rebuild_delay_ = delay;
+}
+
+}  // namespace brave_shields
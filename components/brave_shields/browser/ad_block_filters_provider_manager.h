@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FILTERS_PROVIDER_MANAGER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FILTERS_PROVIDER_MANAGER_H_
+
+#include <map>
+#include <memory>
+
+#include "base/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
+
+using brave_component_updater::DATFileDataBuffer;
+
+class AdBlockFiltersProviderManagerTest;
+
+namespace brave_shields {
+
+// Combines the list text of any number of AdBlockFiltersProviders into a
+// single filter list, so that they can be compiled into one adblock engine.
+// Observers of the manager are notified with the combined list whenever one of
+// the registered providers changes. Changes arriving in quick succession (e.g.
+// all of the lists loading at startup) are coalesced into a single rebuild.
+class AdBlockFiltersProviderManager : public AdBlockFiltersProvider {
+ public:
+  AdBlockFiltersProviderManager();
+  AdBlockFiltersProviderManager(const AdBlockFiltersProviderManager&) = delete;
+  AdBlockFiltersProviderManager& operator=(
+      const AdBlockFiltersProviderManager&) = delete;
+  ~AdBlockFiltersProviderManager() override;
+
+  // Registers |provider| and starts loading its filters. The provider must
+  // outlive its registration. If the provider turns out to only have a
+  // serialized engine, which can't be merged, it is unregistered and
+  // |on_not_mergeable| is run so that it can be given an engine of its own.
+  void AddProvider(AdBlockFiltersProvider* provider,
+                   base::OnceClosure on_not_mergeable = base::OnceClosure());
+  void RemoveProvider(AdBlockFiltersProvider* provider);
+  // Reloads the filters of an already registered |provider|.
+  void ReloadProvider(AdBlockFiltersProvider* provider);
+  bool HasProvider(AdBlockFiltersProvider* provider) const;
+
+  void LoadDATBuffer(
+      base::OnceCallback<void(bool deserialize,
+                              const DATFileDataBuffer& dat_buf)>) override;
+
+ private:
+  friend class ::AdBlockFiltersProviderManagerTest;
+
+  class ProviderObserver : public AdBlockFiltersProvider::Observer {
+   public:
+    ProviderObserver(AdBlockFiltersProviderManager* manager,
+                     AdBlockFiltersProvider* provider,
+                     base::OnceClosure on_not_mergeable);
+    ProviderObserver(const ProviderObserver&) = delete;
+    ProviderObserver& operator=(const ProviderObserver&) = delete;
+    ~ProviderObserver() override;
+
+    // AdBlockFiltersProvider::Observer
+    void OnDATLoaded(bool deserialize,
+                     const DATFileDataBuffer& dat_buf) override;
+    void OnSerializedDATFileReady(const base::FilePath& dat_file_path) override;
+
+    base::OnceClosure TakeNotMergeableCallback();
+
+   private:
+    raw_ptr<AdBlockFiltersProviderManager> manager_;  // not owned
+    raw_ptr<AdBlockFiltersProvider> provider_;        // not owned
+    base::OnceClosure on_not_mergeable_;
+  };
+
+  void OnProviderDATLoaded(AdBlockFiltersProvider* provider,
+                           bool deserialize,
+                           const DATFileDataBuffer& dat_buf);
+  void OnProviderNotMergeable(AdBlockFiltersProvider* provider);
+  void RemoveNotMergeableProvider(AdBlockFiltersProvider* provider,
+                                  base::OnceClosure on_not_mergeable);
+  void ScheduleRebuild();
+  void NotifyCombinedFiltersChanged();
+  DATFileDataBuffer GetCombinedFilters() const;
+
+  void SetRebuildDelayForTest(base::TimeDelta delay);
+
+  std::map<AdBlockFiltersProvider*, std::unique_ptr<ProviderObserver>>
+      provider_observers_;
+  std::map<AdBlockFiltersProvider*, DATFileDataBuffer> provider_filters_;
+  base::TimeDelta rebuild_delay_;
+  base::OneShotTimer rebuild_timer_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<AdBlockFiltersProviderManager> weak_factory_{this};
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FILTERS_PROVIDER_MANAGER_H_
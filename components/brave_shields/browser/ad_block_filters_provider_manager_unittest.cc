@@ -0,0 +1,122 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_filters_provider_manager.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_shields/browser/test_filters_provider.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::AdBlockFiltersProvider;
+using brave_shields::AdBlockFiltersProviderManager;
+using brave_shields::TestFiltersProvider;
+
+namespace {
+
+class TestObserver : public AdBlockFiltersProvider::Observer {
+ public:
+  void OnDATLoaded(bool deserialize,
+                   const DATFileDataBuffer& dat_buf) override {
+    ++load_count;
+    last_deserialize = deserialize;
+    last_filters = std::string(dat_buf.begin(), dat_buf.end());
+  }
+
+  int load_count = 0;
+  bool last_deserialize = true;
+  std::string last_filters;
+};
+
+}  // namespace
+
+class AdBlockFiltersProviderManagerTest : public testing::Test {
+ public:
+  AdBlockFiltersProviderManagerTest() = default;
+  ~AdBlockFiltersProviderManagerTest() override = default;
+
+  void SetUp() override {
+    manager_ = std::make_unique<AdBlockFiltersProviderManager>();
+    manager_->AddObserver(&observer_);
+  }
+
+  void TearDown() override { manager_->RemoveObserver(&observer_); }
+
+  void SimulateProviderDATLoaded(AdBlockFiltersProvider* provider,
+                                 bool deserialize,
+                                 const DATFileDataBuffer& dat_buf) {
+    manager_->OnProviderDATLoaded(provider, deserialize, dat_buf);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::unique_ptr<AdBlockFiltersProviderManager> manager_;
+  TestObserver observer_;
+};
+
+TEST_F(AdBlockFiltersProviderManagerTest, CombinesProviders) {
+  TestFiltersProvider first("||first.com^", "[]");
+  TestFiltersProvider second("||second.com^", "[]");
+
+  manager_->AddProvider(&first);
+  manager_->AddProvider(&second);
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  // Both loads are coalesced into a single rebuild.
+  EXPECT_EQ(observer_.load_count, 1);
+  EXPECT_FALSE(observer_.last_deserialize);
+  EXPECT_NE(observer_.last_filters.find("||first.com^\n"), std::string::npos);
+  EXPECT_NE(observer_.last_filters.find("||second.com^\n"), std::string::npos);
+
+  manager_->RemoveProvider(&first);
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  EXPECT_EQ(observer_.load_count, 2);
+  EXPECT_EQ(observer_.last_filters, "||second.com^\n");
+
+  manager_->RemoveProvider(&second);
+}
+
+TEST_F(AdBlockFiltersProviderManagerTest, FallsBackForSerializedData) {
+  TestFiltersProvider list("||list.com^", "[]");
+  TestFiltersProvider serialized_list("||serialized.com^", "[]");
+  bool not_mergeable = false;
+  manager_->AddProvider(&list);
+  manager_->AddProvider(&serialized_list,
+                        base::BindLambdaForTesting([&]() {
+                          not_mergeable = true;
+                        }));
+  task_environment_.FastForwardUntilNoTasksRemain();
+  ASSERT_EQ(observer_.load_count, 1);
+
+  // A serialized engine can't be merged, so the provider is handed back to
+  // get an engine of its own, and its list text is dropped.
+  DATFileDataBuffer serialized = {0x1f, 0x8b, 0x08};
+  SimulateProviderDATLoaded(&serialized_list, true, serialized);
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  EXPECT_TRUE(not_mergeable);
+  EXPECT_FALSE(manager_->HasProvider(&serialized_list));
+  EXPECT_EQ(observer_.load_count, 2);
+  EXPECT_EQ(observer_.last_filters, "||list.com^\n");
+
+  manager_->RemoveProvider(&list);
+}
+
+TEST_F(AdBlockFiltersProviderManagerTest, NoProvidersLoaded) {
+  bool called = false;
+  manager_->LoadDATBuffer(base::BindOnce(
+      [](bool* called, bool deserialize, const DATFileDataBuffer& dat_buf) {
+        *called = true;
+      },
+      &called));
+
+  EXPECT_FALSE(called);
+}
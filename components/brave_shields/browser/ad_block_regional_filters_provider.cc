@@ -9,15 +9,31 @@
 #include <string>
 #include <utility>
 
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/task/thread_pool.h"
 #include "brave/components/brave_shields/browser/ad_block_component_installer.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "components/component_updater/component_updater_service.h"
 #include "content/public/browser/browser_task_traits.h"
 
 namespace brave_shields {
 
+namespace {
+
+// Only shipped by versions of the component built for the merged engine.
+const char kListFile[] = "list.txt";
+
+// The merged engine is compiled from list text, because serialized engines
+// can't be combined.
+bool ShouldLoadListText() {
+  return base::FeatureList::IsEnabled(features::kBraveAdblockMergedEngine);
+}
+
+}  // namespace
+
 AdBlockRegionalFiltersProvider::AdBlockRegionalFiltersProvider(
     component_updater::ComponentUpdateService* cus,
     const adblock::FilterList& catalog_entry)
@@ -39,35 +55,82 @@ AdBlockRegionalFiltersProvider::~AdBlockRegionalFiltersProvider() {}
 void AdBlockRegionalFiltersProvider::OnComponentReady(
     const base::FilePath& path) {
   component_path_ = path;
+  has_list_text_.reset();
+
+  if (!ShouldLoadListText()) {
+    // The DAT is mapped directly by the engine
+    OnSerializedDATFileReady(GetDATFilePath());
+    return;
+  }
+
+  // Not every version of the component ships the list text, check for it
+  // before deciding how to load the list.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()},
+      base::BindOnce(&base::PathExists, GetListFilePath()),
+      base::BindOnce(&AdBlockRegionalFiltersProvider::OnListTextChecked,
+                     weak_factory_.GetWeakPtr(), component_path_));
+}
+
+void AdBlockRegionalFiltersProvider::OnListTextChecked(
+    const base::FilePath& component_path,
+    bool has_list_text) {
+  if (component_path != component_path_) {
+    // A newer version of the component is being checked.
+    return;
+  }
 
-  base::FilePath dat_file_path =
-      component_path_.AppendASCII(std::string("rs-") + uuid_)
-          .AddExtension(FILE_PATH_LITERAL(".dat"));
+  has_list_text_ = has_list_text;
+  if (!has_list_text) {
+    // Observers that can only use list text have to fall back to the DAT.
+    VLOG(1) << "No list text for regional list " << uuid_;
+    OnSerializedDATFileReady(GetDATFilePath());
+    return;
+  }
 
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::ReadDATFileData, dat_file_path),
+      base::BindOnce(&brave_component_updater::ReadDATFileData,
+                     GetListFilePath()),
       base::BindOnce(&AdBlockRegionalFiltersProvider::OnDATLoaded,
-                     weak_factory_.GetWeakPtr(), true));
+                     weak_factory_.GetWeakPtr(), false));
+}
+
+base::FilePath AdBlockRegionalFiltersProvider::GetSerializedDATFilePath()
+    const {
+  if (component_path_.empty())
+    return base::FilePath();
+
+  if (ShouldLoadListText() && has_list_text_.value_or(true))
+    return base::FilePath();
+
+  return GetDATFilePath();
+}
+
+base::FilePath AdBlockRegionalFiltersProvider::GetDATFilePath() const {
+  return component_path_.AppendASCII(std::string("rs-") + uuid_)
+      .AddExtension(FILE_PATH_LITERAL(".dat"));
+}
+
+base::FilePath AdBlockRegionalFiltersProvider::GetListFilePath() const {
+  return component_path_.AppendASCII(kListFile);
 }
 
 void AdBlockRegionalFiltersProvider::LoadDATBuffer(
     base::OnceCallback<void(bool deserialize, const DATFileDataBuffer& dat_buf)>
         cb) {
-  if (component_path_.empty()) {
-    // If the path is not ready yet, do nothing. An update should be pushed
-    // soon.
+  if (component_path_.empty() || (ShouldLoadListText() && !has_list_text_)) {
+    // If the path is not ready or not checked yet, do nothing. An update
+    // should be pushed soon.
     return;
   }
 
-  base::FilePath dat_file_path =
-      component_path_.AppendASCII(std::string("rs-") + uuid_)
-          .AddExtension(FILE_PATH_LITERAL(".dat"));
-
+  const bool load_list_text = ShouldLoadListText() && *has_list_text_;
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::ReadDATFileData, dat_file_path),
-      base::BindOnce(std::move(cb), true));
+      base::BindOnce(&brave_component_updater::ReadDATFileData,
+                     load_list_text ? GetListFilePath() : GetDATFilePath()),
+      base::BindOnce(std::move(cb), !load_list_text));
 }
 
 bool AdBlockRegionalFiltersProvider::Delete() && {
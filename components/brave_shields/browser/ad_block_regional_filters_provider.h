@@ -48,8 +48,18 @@ class AdBlockRegionalFiltersProvider : public AdBlockFiltersProvider {
   friend class ::AdBlockServiceTest;
 
   void OnComponentReady(const base::FilePath&);
+  void OnListTextChecked(const base::FilePath& component_path,
+                         bool has_list_text);
+  base::FilePath GetDATFilePath() const;
+  base::FilePath GetListFilePath() const;
+
+  // AdBlockFiltersProvider
+  base::FilePath GetSerializedDATFilePath() const override;
 
   base::FilePath component_path_;
+  // Whether the component ships the list text needed by the merged engine.
+  // Unset until it has been checked, or when the merged engine isn't used.
+  absl::optional<bool> has_list_text_;
   std::string uuid_;
   std::string component_id_;
   component_updater::ComponentUpdateService* component_updater_service_;
@@ -9,12 +9,14 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/contains.h"
 #include "base/feature_list.h"
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_filters_provider_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -43,10 +45,12 @@ AdBlockRegionalServiceManager::AdBlockRegionalServiceManager(
 
 void AdBlockRegionalServiceManager::Init(
     AdBlockResourceProvider* resource_provider,
-    AdBlockRegionalCatalogProvider* catalog_provider) {
+    AdBlockRegionalCatalogProvider* catalog_provider,
+    AdBlockFiltersProviderManager* filters_provider_manager) {
   DCHECK(!initialized_);
   resource_provider_ = resource_provider;
   catalog_provider_ = catalog_provider;
+  filters_provider_manager_ = filters_provider_manager;
   catalog_provider_->LoadRegionalCatalog(
       base::BindOnce(&AdBlockRegionalServiceManager::OnRegionalCatalogLoaded,
                      weak_factory_.GetWeakPtr()));
@@ -110,31 +114,67 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
     if (enabled) {
       auto catalog_entry =
           brave_shields::FindAdBlockFilterListByUUID(regional_catalog_, uuid);
-      auto existing_engine = regional_services_.find(uuid);
+      auto existing_provider = regional_filters_providers_.find(uuid);
       // Iterating through locally enabled lists - don't disable any engines or
       // update existing engines with a potentially new catalog entry. They'll
       // be handled after a browser restart.
       if (catalog_entry != regional_catalog_.end() &&
-          existing_engine == regional_services_.end()) {
-        auto regional_filters_provider =
-            std::make_unique<AdBlockRegionalFiltersProvider>(
-                component_update_service_, *catalog_entry);
-        auto regional_service =
-            std::unique_ptr<AdBlockEngine, base::OnTaskRunnerDeleter>(
-                new AdBlockEngine(), base::OnTaskRunnerDeleter(task_runner_));
-        auto observer =
-            std::make_unique<AdBlockService::SourceProviderObserver>(
-                regional_service->AsWeakPtr(), regional_filters_provider.get(),
-                resource_provider_, task_runner_);
-        regional_services_.insert({uuid, std::move(regional_service)});
-        regional_filters_providers_.insert(
-            {uuid, std::move(regional_filters_provider)});
-        regional_source_observers_.insert({uuid, std::move(observer)});
+          existing_provider == regional_filters_providers_.end()) {
+        StartRegionalService(*catalog_entry);
       }
     }
   }
 }
 
+void AdBlockRegionalServiceManager::StartRegionalService(
+    const adblock::FilterList& catalog_entry) {
+  regional_services_lock_.AssertAcquired();
+  const std::string& uuid = catalog_entry.uuid;
+  auto regional_filters_provider =
+      std::make_unique<AdBlockRegionalFiltersProvider>(
+          component_update_service_, catalog_entry);
+  if (filters_provider_manager_) {
+    // The list is compiled into the merged engine, no dedicated engine needed
+    // unless the component only ships the serialized engine.
+    filters_provider_manager_->AddProvider(
+        regional_filters_provider.get(),
+        base::BindOnce(&AdBlockRegionalServiceManager::OnListNotMergeable,
+                       weak_factory_.GetWeakPtr(), uuid));
+    regional_filters_providers_.insert(
+        {uuid, std::move(regional_filters_provider)});
+  } else {
+    regional_filters_providers_.insert(
+        {uuid, std::move(regional_filters_provider)});
+    StartRegionalEngine(uuid);
+  }
+}
+
+void AdBlockRegionalServiceManager::StartRegionalEngine(
+    const std::string& uuid) {
+  regional_services_lock_.AssertAcquired();
+  auto provider = regional_filters_providers_.find(uuid);
+  DCHECK(provider != regional_filters_providers_.end());
+  auto regional_service = std::shared_ptr<AdBlockEngine>(
+      new AdBlockEngine(), base::OnTaskRunnerDeleter(task_runner_));
+  auto observer = std::make_unique<AdBlockService::SourceProviderObserver>(
+      regional_service->AsWeakPtr(), provider->second.get(),
+      resource_provider_, task_runner_);
+  regional_services_.insert({uuid, std::move(regional_service)});
+  regional_source_observers_.insert({uuid, std::move(observer)});
+  PublishEnginesSnapshot();
+}
+
+void AdBlockRegionalServiceManager::OnListNotMergeable(
+    const std::string& uuid) {
+  base::AutoLock lock(regional_services_lock_);
+  // The list may have been disabled in the meantime.
+  if (!base::Contains(regional_filters_providers_, uuid) ||
+      base::Contains(regional_services_, uuid)) {
+    return;
+  }
+  StartRegionalEngine(uuid);
+}
+
 void AdBlockRegionalServiceManager::UpdateFilterListPrefs(
     const std::string& uuid,
     bool enabled) {
@@ -152,6 +192,25 @@ void AdBlockRegionalServiceManager::UpdateFilterListPrefs(
   }
 }
 
+void AdBlockRegionalServiceManager::PublishEnginesSnapshot() {
+  regional_services_lock_.AssertAcquired();
+  std::vector<std::shared_ptr<AdBlockEngine>> engines;
+  engines.reserve(regional_services_.size());
+  for (const auto& regional_service : regional_services_) {
+    engines.push_back(regional_service.second);
+  }
+  auto engines_snapshot =
+      base::MakeRefCounted<AdBlockEngineSnapshot>(std::move(engines));
+  base::AutoLock lock(engines_snapshot_lock_);
+  engines_snapshot_ = std::move(engines_snapshot);
+}
+
+scoped_refptr<const AdBlockEngineSnapshot>
+AdBlockRegionalServiceManager::GetEnginesSnapshot() const {
+  base::AutoLock lock(engines_snapshot_lock_);
+  return engines_snapshot_;
+}
+
 bool AdBlockRegionalServiceManager::Start() {
   return true;
 }
@@ -165,10 +224,13 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
-  base::AutoLock lock(regional_services_lock_);
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return;
 
-  for (const auto& regional_service : regional_services_) {
-    regional_service.second->ShouldStartRequest(
+  for (const auto& regional_service : snapshot->engines()) {
+    regional_service->ShouldStartRequest(
         url, resource_type, tab_host, aggressive_blocking, did_match_rule,
         did_match_exception, did_match_important, mock_data_url);
     if (did_match_important && *did_match_important) {
@@ -177,15 +239,33 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockRegionalServiceManager::ShouldStartRequests(
+    base::span<const AdBlockMatchRequest> requests,
+    base::span<AdBlockMatchResult> results) {
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return;
+
+  for (const auto& regional_service : snapshot->engines()) {
+    regional_service->ShouldStartRequests(requests, results);
+  }
+}
+
 absl::optional<std::string> AdBlockRegionalServiceManager::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
     const std::string& tab_host) {
   absl::optional<std::string> csp_directives = absl::nullopt;
 
-  for (const auto& regional_service : regional_services_) {
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return csp_directives;
+
+  for (const auto& regional_service : snapshot->engines()) {
     const auto directive =
-        regional_service.second->GetCspDirectives(url, resource_type, tab_host);
+        regional_service->GetCspDirectives(url, resource_type, tab_host);
     MergeCspDirectiveInto(directive, &csp_directives);
   }
 
@@ -216,34 +296,24 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
   // Enable or disable the specified filter list
   base::AutoLock lock(regional_services_lock_);
   DCHECK(catalog_entry != regional_catalog_.end());
-  auto it = regional_services_.find(uuid);
+  auto it = regional_filters_providers_.find(uuid);
   if (enabled) {
-    DCHECK(it == regional_services_.end());
-    auto regional_filters_provider =
-        std::make_unique<AdBlockRegionalFiltersProvider>(
-            component_update_service_, *catalog_entry);
-    auto regional_service =
-        std::unique_ptr<AdBlockEngine, base::OnTaskRunnerDeleter>(
-            new AdBlockEngine(), base::OnTaskRunnerDeleter(task_runner_));
-    auto observer = std::make_unique<AdBlockService::SourceProviderObserver>(
-        regional_service->AsWeakPtr(), regional_filters_provider.get(),
-        resource_provider_, task_runner_);
-    regional_services_.insert({uuid, std::move(regional_service)});
-    regional_filters_providers_.insert(
-        {uuid, std::move(regional_filters_provider)});
-    regional_source_observers_.insert({uuid, std::move(observer)});
+    DCHECK(it == regional_filters_providers_.end());
+    StartRegionalService(*catalog_entry);
   } else {
-    auto observer = regional_source_observers_.find(uuid);
-    DCHECK(observer != regional_source_observers_.end());
-    regional_source_observers_.erase(observer);
-
-    DCHECK(it != regional_services_.end());
-    regional_services_.erase(it);
+    DCHECK(it != regional_filters_providers_.end());
+    if (filters_provider_manager_) {
+      filters_provider_manager_->RemoveProvider(it->second.get());
+    }
+    // In merged mode, lists only have a dedicated engine if they couldn't be
+    // merged.
+    if (regional_source_observers_.erase(uuid)) {
+      regional_services_.erase(uuid);
+      PublishEnginesSnapshot();
+    }
 
-    auto it2 = regional_filters_providers_.find(uuid);
-    DCHECK(it2 != regional_filters_providers_.end());
-    std::move(*it2->second).Delete();
-    regional_filters_providers_.erase(it2);
+    std::move(*it->second).Delete();
+    regional_filters_providers_.erase(it);
   }
 
   // Update preferences to reflect enabled/disabled state of specified
@@ -256,17 +326,16 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
 
 absl::optional<base::Value> AdBlockRegionalServiceManager::UrlCosmeticResources(
     const std::string& url) {
-  base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot || snapshot->engines().empty()) {
     return absl::optional<base::Value>();
   }
-  absl::optional<base::Value> first_value =
-      it->second->UrlCosmeticResources(url);
+  auto it = snapshot->engines().begin();
+  absl::optional<base::Value> first_value = (*it)->UrlCosmeticResources(url);
 
-  for (; it != regional_services_.end(); it++) {
-    absl::optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
+  for (++it; it != snapshot->engines().end(); it++) {
+    absl::optional<base::Value> next_value = (*it)->UrlCosmeticResources(url);
     if (first_value) {
       if (next_value) {
         MergeResourcesInto(std::move(*next_value), &*first_value, false);
@@ -285,11 +354,14 @@ base::Value AdBlockRegionalServiceManager::HiddenClassIdSelectors(
     const std::vector<std::string>& exceptions) {
   base::Value first_value(base::Value::Type::LIST);
 
-  base::AutoLock lock(regional_services_lock_);
-  for (auto it = regional_services_.begin(); it != regional_services_.end();
-       it++) {
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return first_value;
+
+  for (const auto& regional_service : snapshot->engines()) {
     base::Value next_value =
-        it->second->HiddenClassIdSelectors(classes, ids, exceptions);
+        regional_service->HiddenClassIdSelectors(classes, ids, exceptions);
     DCHECK(next_value.is_list());
 
     for (auto& value : next_value.GetList()) {
@@ -36,6 +36,7 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class AdBlockFiltersProviderManager;
 class AdBlockRegionalService;
 
 // The AdBlock regional service manager, in charge of initializing and
@@ -67,6 +68,10 @@ class AdBlockRegionalServiceManager
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  // Batched version of ShouldStartRequest, which only takes the lock once for
+  // the whole batch.
+  void ShouldStartRequests(base::span<const AdBlockMatchRequest> requests,
+                           base::span<AdBlockMatchResult> results);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -81,8 +86,12 @@ class AdBlockRegionalServiceManager
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
 
+  // When |filters_provider_manager| is non-null, enabled lists are compiled
+  // into the merged engine instead of getting a dedicated engine each, unless
+  // their component doesn't ship the list text.
   void Init(AdBlockResourceProvider* resource_provider,
-            AdBlockRegionalCatalogProvider* catalog_provider);
+            AdBlockRegionalCatalogProvider* catalog_provider,
+            AdBlockFiltersProviderManager* filters_provider_manager);
 
   // AdBlockRegionalCatalogProvider::Observer
   void OnRegionalCatalogLoaded(const std::string& catalog_json) override;
@@ -90,15 +99,25 @@ class AdBlockRegionalServiceManager
  private:
   friend class ::AdBlockServiceTest;
   void StartRegionalServices();
+  void StartRegionalService(const adblock::FilterList& catalog_entry);
+  // Gives the list with |uuid| an engine of its own.
+  void StartRegionalEngine(const std::string& uuid);
+  void OnListNotMergeable(const std::string& uuid);
   void UpdateFilterListPrefs(const std::string& uuid, bool enabled);
+  void PublishEnginesSnapshot();
+  scoped_refptr<const AdBlockEngineSnapshot> GetEnginesSnapshot() const;
 
   raw_ptr<PrefService> local_state_;
   std::string locale_;
   bool initialized_;
   base::Lock regional_services_lock_;
-  std::map<std::string,
-           std::unique_ptr<AdBlockEngine, base::OnTaskRunnerDeleter>>
-      regional_services_;
+  std::map<std::string, std::shared_ptr<AdBlockEngine>> regional_services_;
+  // Immutable copy of the engines in |regional_services_|, republished
+  // whenever the map changes so that matching never has to wait on
+  // |regional_services_lock_|. Its own lock is only held to copy the pointer.
+  mutable base::Lock engines_snapshot_lock_;
+  scoped_refptr<const AdBlockEngineSnapshot> engines_snapshot_
+      GUARDED_BY(engines_snapshot_lock_);
   std::map<std::string, std::unique_ptr<AdBlockRegionalFiltersProvider>>
       regional_filters_providers_;
   std::map<std::string, std::unique_ptr<AdBlockService::SourceProviderObserver>>
@@ -110,6 +129,7 @@ class AdBlockRegionalServiceManager
   raw_ptr<component_updater::ComponentUpdateService> component_update_service_;
   raw_ptr<AdBlockResourceProvider> resource_provider_;
   raw_ptr<AdBlockRegionalCatalogProvider> catalog_provider_;
+  raw_ptr<AdBlockFiltersProviderManager> filters_provider_manager_ = nullptr;
 
   base::WeakPtrFactory<AdBlockRegionalServiceManager> weak_factory_{this};
 };
@@ -16,11 +16,13 @@
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_default_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_filters_provider_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
@@ -84,6 +86,18 @@ void AdBlockService::SourceProviderObserver::OnDATLoaded(
     const DATFileDataBuffer& dat_buf) {
   deserialize_ = deserialize;
   dat_buf_ = std::move(dat_buf);
+  dat_file_path_.clear();
+  // multiple AddObserver calls are ignored
+  resource_provider_->AddObserver(this);
+  resource_provider_->LoadResources(base::BindOnce(
+      &SourceProviderObserver::OnResourcesLoaded, weak_factory_.GetWeakPtr()));
+}
+
+void AdBlockService::SourceProviderObserver::OnSerializedDATFileReady(
+    const base::FilePath& dat_file_path) {
+  deserialize_ = true;
+  dat_buf_.clear();
+  dat_file_path_ = dat_file_path;
   // multiple AddObserver calls are ignored
   resource_provider_->AddObserver(this);
   resource_provider_->LoadResources(base::BindOnce(
@@ -92,15 +106,60 @@ void AdBlockService::SourceProviderObserver::OnDATLoaded(
 
 void AdBlockService::SourceProviderObserver::OnResourcesLoaded(
     const std::string& resources_json) {
-  if (dat_buf_.empty()) {
+  if (dat_file_path_.empty() && dat_buf_.empty()) {
+    if (is_building_client_) {
+      // The client being built has older resources, which it would bring
+      // back when swapped in. Add these once it is.
+      pending_resources_json_ = resources_json;
+      return;
+    }
     task_runner_->PostTask(
         FROM_HERE, base::BindOnce(&AdBlockEngine::AddResources, adblock_engine_,
                                   resources_json));
+    return;
+  }
+
+  // The new client is built on the thread pool, so that the engine keeps
+  // matching with its current client on |task_runner_| in the meantime.
+  base::OnceCallback<std::unique_ptr<adblock::Engine>()> create_client;
+  if (!dat_file_path_.empty()) {
+    create_client = base::BindOnce(&AdBlockEngine::CreateClientFromFile,
+                                   dat_file_path_, resources_json);
+    // Like |dat_buf_|, the file is only loaded once. Later resource updates
+    // are added to the engine that was built from it.
+    dat_file_path_.clear();
   } else {
+    create_client = base::BindOnce(&AdBlockEngine::CreateClient, deserialize_,
+                                   std::move(dat_buf_), resources_json);
+  }
+
+  // The new client is built with the latest resources.
+  is_building_client_ = true;
+  pending_resources_json_.reset();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      std::move(create_client),
+      base::BindOnce(&SourceProviderObserver::OnClientCreated,
+                     weak_factory_.GetWeakPtr(), ++load_id_));
+}
+
+void AdBlockService::SourceProviderObserver::OnClientCreated(
+    uint64_t load_id,
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  // Drop the client if a newer load was started while it was being built.
+  if (load_id != load_id_) {
+    return;
+  }
+
+  is_building_client_ = false;
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&AdBlockEngine::UpdateAdBlockClient,
+                                adblock_engine_, std::move(ad_block_client)));
+  if (pending_resources_json_) {
     task_runner_->PostTask(
-        FROM_HERE,
-        base::BindOnce(&AdBlockEngine::Load, adblock_engine_, deserialize_,
-                       std::move(dat_buf_), resources_json));
+        FROM_HERE, base::BindOnce(&AdBlockEngine::AddResources, adblock_engine_,
+                                  std::move(*pending_resources_json_)));
+    pending_resources_json_.reset();
   }
 }
 
@@ -128,6 +187,17 @@ void AdBlockService::ShouldStartRequest(
     }
   }
 
+  if (merged_service()) {
+    // Regional lists and subscriptions are compiled into a single engine.
+    merged_service()->ShouldStartRequest(
+        url, resource_type, tab_host, aggressive_blocking, did_match_rule,
+        did_match_exception, did_match_important, mock_data_url);
+    if (did_match_important && *did_match_important) {
+      return;
+    }
+  }
+
+  // Lists that couldn't be merged still have an engine of their own.
   regional_service_manager()->ShouldStartRequest(
       url, resource_type, tab_host, aggressive_blocking, did_match_rule,
       did_match_exception, did_match_important, mock_data_url);
@@ -147,6 +217,36 @@ void AdBlockService::ShouldStartRequest(
       did_match_exception, did_match_important, mock_data_url);
 }
 
+void AdBlockService::ShouldStartRequests(
+    base::span<const AdBlockMatchRequest> requests,
+    base::span<AdBlockMatchResult> results) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  DCHECK_EQ(requests.size(), results.size());
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const AdBlockMatchRequest& request = requests[i];
+    if (request.aggressive_blocking ||
+        base::FeatureList::IsEnabled(
+            brave_shields::features::kBraveAdblockDefault1pBlocking) ||
+        !SameDomainOrHost(
+            request.url,
+            url::Origin::CreateFromNormalizedTuple("https", request.tab_host,
+                                                   80),
+            net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+      default_service()->ShouldStartRequests(requests.subspan(i, 1),
+                                             results.subspan(i, 1));
+    }
+  }
+
+  // Requests that matched an important rule are skipped by the engines below.
+  if (merged_service()) {
+    merged_service()->ShouldStartRequests(requests, results);
+  }
+  regional_service_manager()->ShouldStartRequests(requests, results);
+  subscription_service_manager()->ShouldStartRequests(requests, results);
+  custom_filters_service()->ShouldStartRequests(requests, results);
+}
+
 absl::optional<std::string> AdBlockService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -155,6 +255,12 @@ absl::optional<std::string> AdBlockService::GetCspDirectives(
   auto csp_directives =
       default_service()->GetCspDirectives(url, resource_type, tab_host);
 
+  if (merged_service()) {
+    const auto merged_csp =
+        merged_service()->GetCspDirectives(url, resource_type, tab_host);
+    MergeCspDirectiveInto(merged_csp, &csp_directives);
+  }
+
   const auto regional_csp = regional_service_manager()->GetCspDirectives(
       url, resource_type, tab_host);
   MergeCspDirectiveInto(regional_csp, &csp_directives);
@@ -176,6 +282,19 @@ absl::optional<base::Value> AdBlockService::UrlCosmeticResources(
     return resources;
   }
 
+  if (merged_service()) {
+    // Holds the subscription lists, which are force hidden, along with any
+    // regional lists shipped as text. Those can't be told apart here, so they
+    // are force hidden too, as HiddenClassIdSelectors() already does.
+    absl::optional<base::Value> merged_resources =
+        merged_service()->UrlCosmeticResources(url);
+
+    if (merged_resources && merged_resources->is_dict()) {
+      MergeResourcesInto(std::move(*merged_resources), &*resources,
+                         /*force_hide=*/true);
+    }
+  }
+
   absl::optional<base::Value> regional_resources =
       regional_service_manager()->UrlCosmeticResources(url);
 
@@ -237,6 +356,15 @@ base::Value AdBlockService::HiddenClassIdSelectors(
 
   base::Value force_hide_selectors = std::move(regional_selectors);
 
+  if (merged_service()) {
+    base::Value merged_selectors =
+        merged_service()->HiddenClassIdSelectors(classes, ids, exceptions);
+    DCHECK(merged_selectors.is_list());
+    for (auto& merged_selector : merged_selectors.GetList()) {
+      force_hide_selectors.Append(std::move(merged_selector));
+    }
+  }
+
   for (auto& custom_selector : custom_selectors.GetList()) {
     force_hide_selectors.Append(std::move(custom_selector));
   }
@@ -257,7 +385,8 @@ AdBlockRegionalServiceManager* AdBlockService::regional_service_manager() {
         brave_shields::AdBlockRegionalServiceManagerFactory(
             local_state_, locale_, component_update_service_, GetTaskRunner());
     regional_service_manager_->Init(default_filters_provider_.get(),
-                                    default_filters_provider_.get());
+                                    default_filters_provider_.get(),
+                                    filters_provider_manager_.get());
   }
   return regional_service_manager_.get();
 }
@@ -286,6 +415,20 @@ AdBlockEngine* AdBlockService::custom_filters_service() {
   return custom_filters_service_.get();
 }
 
+AdBlockEngine* AdBlockService::merged_service() {
+  if (!filters_provider_manager_)
+    return nullptr;
+  if (!merged_service_) {
+    merged_service_ =
+        std::unique_ptr<AdBlockEngine, base::OnTaskRunnerDeleter>(
+            new AdBlockEngine(), base::OnTaskRunnerDeleter(GetTaskRunner()));
+    merged_service_observer_ = std::make_unique<SourceProviderObserver>(
+        merged_service_->AsWeakPtr(), filters_provider_manager_.get(),
+        default_filters_provider_.get(), GetTaskRunner());
+  }
+  return merged_service_.get();
+}
+
 brave_shields::AdBlockCustomFiltersProvider*
 AdBlockService::custom_filters_provider() {
   return custom_filters_provider_.get();
@@ -294,7 +437,8 @@ AdBlockService::custom_filters_provider() {
 brave_shields::AdBlockSubscriptionServiceManager*
 AdBlockService::subscription_service_manager() {
   if (!subscription_service_manager_->IsInitialized()) {
-    subscription_service_manager_->Init(default_filters_provider_.get());
+    subscription_service_manager_->Init(default_filters_provider_.get(),
+                                        filters_provider_manager_.get());
   }
   return subscription_service_manager_.get();
 }
@@ -312,7 +456,8 @@ AdBlockService::AdBlockService(
       task_runner_(task_runner),
       custom_filters_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
       default_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
-      subscription_service_manager_(std::move(subscription_service_manager)) {
+      subscription_service_manager_(std::move(subscription_service_manager)),
+      merged_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)) {
   // Initializes adblock-rust's domain resolution implementation
   adblock::SetDomainResolver(AdBlockServiceDomainResolver);
 
@@ -322,6 +467,10 @@ AdBlockService::AdBlockService(
   custom_filters_provider_ =
       std::make_unique<brave_shields::AdBlockCustomFiltersProvider>(
           local_state_);
+  if (base::FeatureList::IsEnabled(features::kBraveAdblockMergedEngine)) {
+    filters_provider_manager_ =
+        std::make_unique<brave_shields::AdBlockFiltersProviderManager>();
+  }
 }
 
 AdBlockService::~AdBlockService() {}
@@ -332,6 +481,7 @@ bool AdBlockService::Start() {
   // Initialize each service:
   default_service();
   custom_filters_service();
+  merged_service();
   regional_service_manager();
   subscription_service_manager();
 
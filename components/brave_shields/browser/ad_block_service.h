@@ -12,11 +12,13 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_resource_provider.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -34,6 +36,10 @@ class PerfPredictorTabHelperTest;
 class PrefChangeRegistrar;
 class PrefService;
 
+namespace adblock {
+class Engine;
+}  // namespace adblock
+
 namespace component_updater {
 class ComponentUpdateService;
 }  // namespace component_updater
@@ -42,6 +48,7 @@ namespace brave_shields {
 
 class AdBlockEngine;
 class AdBlockDefaultFiltersProvider;
+class AdBlockFiltersProviderManager;
 class AdBlockRegionalServiceManager;
 class AdBlockCustomFiltersProvider;
 class AdBlockRegionalCatalogProvider;
@@ -66,12 +73,25 @@ class AdBlockService {
     // AdBlockFiltersProvider::Observer
     void OnDATLoaded(bool deserialize,
                      const DATFileDataBuffer& dat_buf) override;
+    void OnSerializedDATFileReady(const base::FilePath& dat_file_path) override;
 
     // AdBlockResourceProvider::Observer
     void OnResourcesLoaded(const std::string& resources_json) override;
 
+    void OnClientCreated(uint64_t load_id,
+                         std::unique_ptr<adblock::Engine> ad_block_client);
+
     bool deserialize_;
     DATFileDataBuffer dat_buf_;
+    // Set instead of |dat_buf_| when the engine should map the file itself.
+    // Cleared once a client is being built from it.
+    base::FilePath dat_file_path_;
+    // Identifies the most recent load, so that clients built from stale data
+    // are never swapped in over newer ones.
+    uint64_t load_id_ = 0;
+    bool is_building_client_ = false;
+    // Resources that were loaded while a client was being built.
+    absl::optional<std::string> pending_resources_json_;
     base::WeakPtr<AdBlockEngine> adblock_engine_;
     raw_ptr<AdBlockFiltersProvider> filters_provider_;    // not owned
     raw_ptr<AdBlockResourceProvider> resource_provider_;  // not owned
@@ -98,6 +118,11 @@ class AdBlockService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  // Checks a batch of requests at once, amortizing lock acquisition and
+  // iteration over the engines across the batch. |results| must have the same
+  // size as |requests|.
+  void ShouldStartRequests(base::span<const AdBlockMatchRequest> requests,
+                           base::span<AdBlockMatchResult> results);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -131,6 +156,9 @@ class AdBlockService {
   static std::string g_ad_block_dat_file_version_;
 
   AdBlockResourceProvider* resource_provider();
+  // The engine that regional lists and subscriptions are compiled into, or
+  // nullptr when the merged engine is disabled.
+  AdBlockEngine* merged_service();
 
   void UseSourceProvidersForTest(AdBlockFiltersProvider* source_provider,
                                  AdBlockResourceProvider* resource_provider);
@@ -159,9 +187,16 @@ class AdBlockService {
       default_service_;
   std::unique_ptr<brave_shields::AdBlockSubscriptionServiceManager>
       subscription_service_manager_;
+  // Only set when the merged engine is enabled. It observes providers owned by
+  // the members above, so it has to be destroyed before them.
+  std::unique_ptr<brave_shields::AdBlockFiltersProviderManager>
+      filters_provider_manager_;
+  std::unique_ptr<brave_shields::AdBlockEngine, base::OnTaskRunnerDeleter>
+      merged_service_;
 
   std::unique_ptr<SourceProviderObserver> default_service_observer_;
   std::unique_ptr<SourceProviderObserver> custom_filters_service_observer_;
+  std::unique_ptr<SourceProviderObserver> merged_service_observer_;
 
   SEQUENCE_CHECKER(sequence_checker_);
 
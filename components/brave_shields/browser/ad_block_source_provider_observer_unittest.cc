@@ -0,0 +1,94 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/test_filters_provider.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/gurl.h"
+
+using brave_shields::AdBlockEngine;
+using brave_shields::AdBlockService;
+using brave_shields::TestFiltersProvider;
+
+namespace {
+
+// Lets tests deliver resource updates, like the resource providers do when
+// their component is updated.
+class TestResourceUpdatesProvider : public TestFiltersProvider {
+ public:
+  using TestFiltersProvider::TestFiltersProvider;
+
+  void UpdateResources(const std::string& resources_json) {
+    OnResourcesLoaded(resources_json);
+  }
+};
+
+std::string MakeResources(const std::string& base64_content) {
+  return base::StringPrintf(R"([{
+    "name": "noop.js",
+    "aliases": ["noopjs"],
+    "kind": {"mime": "application/javascript"},
+    "content": "%s"
+  }])",
+                            base64_content.c_str());
+}
+
+}  // namespace
+
+class AdBlockSourceProviderObserverTest : public testing::Test {
+ public:
+  AdBlockSourceProviderObserverTest() = default;
+  ~AdBlockSourceProviderObserverTest() override = default;
+
+  std::string GetMockDataURL() {
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string mock_data_url;
+    engine_.ShouldStartRequest(GURL("https://example.com/js_mock_me.js"),
+                               blink::mojom::ResourceType::kScript,
+                               "example.com", false, &did_match_rule,
+                               &did_match_exception, &did_match_important,
+                               &mock_data_url);
+    EXPECT_TRUE(did_match_rule);
+    return mock_data_url;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  AdBlockEngine engine_;
+};
+
+TEST_F(AdBlockSourceProviderObserverTest, KeepsResourcesLoadedDuringBuild) {
+  // "Zmlyc3Q=", "c2Vjb25k" and "dGhpcmQ=" are "first", "second" and "third".
+  TestResourceUpdatesProvider provider("js_mock_me.js$redirect=noopjs",
+                                       MakeResources("Zmlyc3Q="));
+  // Starts building a client with the first resources on the thread pool.
+  AdBlockService::SourceProviderObserver observer(
+      engine_.AsWeakPtr(), &provider, &provider,
+      base::SequencedTaskRunnerHandle::Get());
+
+  // Both updates arrive before the client is swapped in, and must not be
+  // replaced by the resources it was built with.
+  provider.UpdateResources(MakeResources("c2Vjb25k"));
+  provider.UpdateResources(MakeResources("dGhpcmQ="));
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(GetMockDataURL(), "data:application/javascript;base64,dGhpcmQ=");
+
+  // Once the client is in place, updates are added directly.
+  provider.UpdateResources(MakeResources("c2Vjb25k"));
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(GetMockDataURL(), "data:application/javascript;base64,c2Vjb25k");
+}
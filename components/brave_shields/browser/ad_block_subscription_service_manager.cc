@@ -22,6 +22,7 @@
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_filters_provider_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager_observer.h"
@@ -110,8 +111,10 @@ AdBlockSubscriptionServiceManager::AdBlockSubscriptionServiceManager(
 }
 
 void AdBlockSubscriptionServiceManager::Init(
-    AdBlockResourceProvider* resource_provider) {
+    AdBlockResourceProvider* resource_provider,
+    AdBlockFiltersProviderManager* filters_provider_manager) {
   resource_provider_ = resource_provider;
+  filters_provider_manager_ = filters_provider_manager;
   initialized_ = true;
 }
 
@@ -180,6 +183,7 @@ void AdBlockSubscriptionServiceManager::OnUpdateTimer(
       }
     }
   }
+  PublishEnginesSnapshot();
 
   std::move(on_finished).Run();
 }
@@ -201,7 +205,7 @@ void AdBlockSubscriptionServiceManager::CreateSubscription(
     const GURL& sub_url) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  if (base::Contains(subscription_services_, sub_url)) {
+  if (base::Contains(subscription_filters_providers_, sub_url)) {
     return;
   }
 
@@ -211,28 +215,11 @@ void AdBlockSubscriptionServiceManager::CreateSubscription(
   info.last_successful_update_attempt = base::Time();
   info.enabled = true;
 
-  auto subscription_service =
-      std::unique_ptr<AdBlockEngine, base::OnTaskRunnerDeleter>(
-          new AdBlockEngine(), base::OnTaskRunnerDeleter(task_runner_));
   UpdateSubscriptionPrefs(sub_url, info);
 
-  auto subscription_filters_provider =
-      std::make_unique<AdBlockSubscriptionFiltersProvider>(
-          local_state_,
-          GetSubscriptionPath(sub_url).Append(kCustomSubscriptionListText));
-  auto observer = std::make_unique<AdBlockService::SourceProviderObserver>(
-      subscription_service->AsWeakPtr(), subscription_filters_provider.get(),
-      resource_provider_, task_runner_);
-
   {
     base::AutoLock lock(subscription_services_lock_);
-    // this could allow more than one service for a given url
-    subscription_services_.insert(
-        std::make_pair(sub_url, std::move(subscription_service)));
-    subscription_filters_providers_.insert(
-        std::make_pair(sub_url, std::move(subscription_filters_provider)));
-    subscription_source_observers_.insert(
-        std::make_pair(sub_url, std::move(observer)));
+    StartSubscriptionService(sub_url, info.enabled);
   }
 
   StartDownload(sub_url, true);
@@ -243,8 +230,9 @@ AdBlockSubscriptionServiceManager::GetSubscriptions() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   auto infos = std::vector<SubscriptionInfo>();
 
-  for (const auto& subscription_service : subscription_services_) {
-    auto info = GetInfo(subscription_service.first);
+  for (const auto& subscription_filters_provider :
+       subscription_filters_providers_) {
+    auto info = GetInfo(subscription_filters_provider.first);
     DCHECK(info);
     infos.push_back(*info);
   }
@@ -261,6 +249,17 @@ void AdBlockSubscriptionServiceManager::EnableSubscription(const GURL& sub_url,
   info->enabled = enabled;
 
   UpdateSubscriptionPrefs(sub_url, *info);
+
+  if (filters_provider_manager_) {
+    // Disabled lists are left out of the merged engine entirely.
+    auto it = subscription_filters_providers_.find(sub_url);
+    DCHECK(it != subscription_filters_providers_.end());
+    if (enabled) {
+      filters_provider_manager_->AddProvider(it->second.get());
+    } else {
+      filters_provider_manager_->RemoveProvider(it->second.get());
+    }
+  }
 }
 
 void AdBlockSubscriptionServiceManager::DeleteSubscription(
@@ -268,14 +267,19 @@ void AdBlockSubscriptionServiceManager::DeleteSubscription(
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   {
     base::AutoLock lock(subscription_services_lock_);
-    auto observer = subscription_source_observers_.find(sub_url);
-    DCHECK(observer != subscription_source_observers_.end());
-    subscription_source_observers_.erase(observer);
-    auto it = subscription_services_.find(sub_url);
-    DCHECK(it != subscription_services_.end());
-    subscription_services_.erase(it);
     auto it2 = subscription_filters_providers_.find(sub_url);
     DCHECK(it2 != subscription_filters_providers_.end());
+    if (filters_provider_manager_) {
+      filters_provider_manager_->RemoveProvider(it2->second.get());
+    } else {
+      auto observer = subscription_source_observers_.find(sub_url);
+      DCHECK(observer != subscription_source_observers_.end());
+      subscription_source_observers_.erase(observer);
+      auto it = subscription_services_.find(sub_url);
+      DCHECK(it != subscription_services_.end());
+      subscription_services_.erase(it);
+      PublishEnginesSnapshot();
+    }
     subscription_filters_providers_.erase(it2);
   }
   ClearSubscriptionPrefs(sub_url);
@@ -361,27 +365,43 @@ void AdBlockSubscriptionServiceManager::LoadSubscriptionServices() {
       GURL sub_url(key);
       info = BuildInfoFromDict(sub_url, list_subscription_dict);
 
-      auto subscription_service =
-          std::unique_ptr<AdBlockEngine, base::OnTaskRunnerDeleter>(
-              new AdBlockEngine(), base::OnTaskRunnerDeleter(task_runner_));
-
-      auto subscription_filters_provider =
-          std::make_unique<AdBlockSubscriptionFiltersProvider>(
-              local_state_,
-              GetSubscriptionPath(sub_url).Append(kCustomSubscriptionListText));
-      auto observer = std::make_unique<AdBlockService::SourceProviderObserver>(
-          subscription_service->AsWeakPtr(),
-          subscription_filters_provider.get(), resource_provider_,
-          task_runner_);
-
-      subscription_services_.insert(
-          std::make_pair(sub_url, std::move(subscription_service)));
-      subscription_filters_providers_.insert(
-          std::make_pair(sub_url, std::move(subscription_filters_provider)));
-      subscription_source_observers_.insert(
-          std::make_pair(sub_url, std::move(observer)));
+      StartSubscriptionService(sub_url, info.enabled);
     }
   }
+  PublishEnginesSnapshot();
+}
+
+void AdBlockSubscriptionServiceManager::StartSubscriptionService(
+    const GURL& sub_url,
+    bool enabled) {
+  subscription_services_lock_.AssertAcquired();
+  auto subscription_filters_provider =
+      std::make_unique<AdBlockSubscriptionFiltersProvider>(
+          local_state_,
+          GetSubscriptionPath(sub_url).Append(kCustomSubscriptionListText));
+
+  if (filters_provider_manager_) {
+    if (enabled) {
+      filters_provider_manager_->AddProvider(
+          subscription_filters_provider.get());
+    }
+  } else {
+    auto subscription_service = std::shared_ptr<AdBlockEngine>(
+        new AdBlockEngine(), base::OnTaskRunnerDeleter(task_runner_));
+    auto observer = std::make_unique<AdBlockService::SourceProviderObserver>(
+        subscription_service->AsWeakPtr(), subscription_filters_provider.get(),
+        resource_provider_, task_runner_);
+
+    // this could allow more than one service for a given url
+    subscription_services_.insert(
+        std::make_pair(sub_url, std::move(subscription_service)));
+    subscription_source_observers_.insert(
+        std::make_pair(sub_url, std::move(observer)));
+    PublishEnginesSnapshot();
+  }
+
+  subscription_filters_providers_.insert(
+      std::make_pair(sub_url, std::move(subscription_filters_provider)));
 }
 
 // Updates preferences to reflect a new state for the specified filter list
@@ -408,6 +428,7 @@ void AdBlockSubscriptionServiceManager::UpdateSubscriptionPrefs(
   base::AutoLock lock(subscription_services_lock_);
   subscriptions_ = base::DictionaryValue::From(
       base::Value::ToUniquePtrValue(subscriptions_dict->Clone()));
+  PublishEnginesSnapshot();
 }
 
 // Updates preferences to remove all state for the specified filter list
@@ -426,6 +447,28 @@ void AdBlockSubscriptionServiceManager::ClearSubscriptionPrefs(
   base::AutoLock lock(subscription_services_lock_);
   subscriptions_ = base::DictionaryValue::From(
       base::Value::ToUniquePtrValue(subscriptions_dict->Clone()));
+  PublishEnginesSnapshot();
+}
+
+void AdBlockSubscriptionServiceManager::PublishEnginesSnapshot() {
+  subscription_services_lock_.AssertAcquired();
+  std::vector<std::shared_ptr<AdBlockEngine>> engines;
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscription_service.first);
+    if (info && info->enabled) {
+      engines.push_back(subscription_service.second);
+    }
+  }
+  auto engines_snapshot =
+      base::MakeRefCounted<AdBlockEngineSnapshot>(std::move(engines));
+  base::AutoLock lock(engines_snapshot_lock_);
+  engines_snapshot_ = std::move(engines_snapshot);
+}
+
+scoped_refptr<const AdBlockEngineSnapshot>
+AdBlockSubscriptionServiceManager::GetEnginesSnapshot() const {
+  base::AutoLock lock(engines_snapshot_lock_);
+  return engines_snapshot_;
 }
 
 bool AdBlockSubscriptionServiceManager::Start() {
@@ -441,20 +484,34 @@ void AdBlockSubscriptionServiceManager::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
-  base::AutoLock lock(subscription_services_lock_);
-  for (const auto& subscription_service : subscription_services_) {
-    auto info = GetInfo(subscription_service.first);
-    if (info && info->enabled) {
-      subscription_service.second->ShouldStartRequest(
-          url, resource_type, tab_host, aggressive_blocking, did_match_rule,
-          did_match_exception, did_match_important, mock_data_url);
-      if (did_match_important && *did_match_important) {
-        return;
-      }
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return;
+
+  for (const auto& subscription_service : snapshot->engines()) {
+    subscription_service->ShouldStartRequest(
+        url, resource_type, tab_host, aggressive_blocking, did_match_rule,
+        did_match_exception, did_match_important, mock_data_url);
+    if (did_match_important && *did_match_important) {
+      return;
     }
   }
 }
 
+void AdBlockSubscriptionServiceManager::ShouldStartRequests(
+    base::span<const AdBlockMatchRequest> requests,
+    base::span<AdBlockMatchResult> results) {
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return;
+
+  for (const auto& subscription_service : snapshot->engines()) {
+    subscription_service->ShouldStartRequests(requests, results);
+  }
+}
+
 void AdBlockSubscriptionServiceManager::EnableTag(const std::string& tag,
                                                   bool enabled) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -476,20 +533,20 @@ AdBlockSubscriptionServiceManager::UrlCosmeticResources(
     const std::string& url) {
   absl::optional<base::Value> first_value = absl::nullopt;
 
-  base::AutoLock lock(subscription_services_lock_);
-  for (auto it = subscription_services_.begin();
-       it != subscription_services_.end(); it++) {
-    auto info = GetInfo(it->first);
-    if (info && info->enabled) {
-      absl::optional<base::Value> next_value =
-          it->second->UrlCosmeticResources(url);
-      if (first_value) {
-        if (next_value) {
-          MergeResourcesInto(std::move(*next_value), &*first_value, false);
-        }
-      } else {
-        first_value = std::move(next_value);
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return first_value;
+
+  for (const auto& subscription_service : snapshot->engines()) {
+    absl::optional<base::Value> next_value =
+        subscription_service->UrlCosmeticResources(url);
+    if (first_value) {
+      if (next_value) {
+        MergeResourcesInto(std::move(*next_value), &*first_value, false);
       }
+    } else {
+      first_value = std::move(next_value);
     }
   }
 
@@ -502,18 +559,18 @@ base::Value AdBlockSubscriptionServiceManager::HiddenClassIdSelectors(
     const std::vector<std::string>& exceptions) {
   base::Value first_value(base::Value::Type::LIST);
 
-  base::AutoLock lock(subscription_services_lock_);
-  for (auto it = subscription_services_.begin();
-       it != subscription_services_.end(); it++) {
-    auto info = GetInfo(it->first);
-    if (info && info->enabled) {
-      base::Value next_value =
-          it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-      DCHECK(next_value.is_list());
+  const scoped_refptr<const AdBlockEngineSnapshot> snapshot =
+      GetEnginesSnapshot();
+  if (!snapshot)
+    return first_value;
 
-      for (auto& item : next_value.GetList()) {
-        first_value.Append(std::move(item));
-      }
+  for (const auto& subscription_service : snapshot->engines()) {
+    base::Value next_value =
+        subscription_service->HiddenClassIdSelectors(classes, ids, exceptions);
+    DCHECK(next_value.is_list());
+
+    for (auto& item : next_value.GetList()) {
+      first_value.Append(std::move(item));
     }
   }
 
@@ -536,12 +593,18 @@ void AdBlockSubscriptionServiceManager::OnSubscriptionDownloaded(
   info->last_successful_update_attempt = info->last_update_attempt;
   UpdateSubscriptionPrefs(sub_url, *info);
 
-  auto subscription_source_observer =
-      subscription_source_observers_.find(sub_url);
-  DCHECK(subscription_source_observer != subscription_source_observers_.end());
-
-  subscription_filters_provider->second->LoadDAT(
-      (subscription_source_observer->second).get());
+  if (filters_provider_manager_) {
+    filters_provider_manager_->ReloadProvider(
+        subscription_filters_provider->second.get());
+  } else {
+    auto subscription_source_observer =
+        subscription_source_observers_.find(sub_url);
+    DCHECK(subscription_source_observer !=
+           subscription_source_observers_.end());
+
+    subscription_filters_provider->second->LoadDAT(
+        (subscription_source_observer->second).get());
+  }
 
   NotifyObserversOfServiceEvent();
 }
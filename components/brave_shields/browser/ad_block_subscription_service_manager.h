@@ -36,6 +36,7 @@ class JSONValueConverter;
 }
 
 namespace brave_shields {
+class AdBlockFiltersProviderManager;
 class AdBlockResourceProvider;
 class AdBlockSubscriptionServiceManagerObserver;
 class AdBlockSubscriptionFiltersProvider;
@@ -97,6 +98,10 @@ class AdBlockSubscriptionServiceManager {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  // Batched version of ShouldStartRequest, which only takes the lock once for
+  // the whole batch.
+  void ShouldStartRequests(base::span<const AdBlockMatchRequest> requests,
+                           base::span<AdBlockMatchResult> results);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
 
@@ -116,7 +121,11 @@ class AdBlockSubscriptionServiceManager {
   void AddObserver(AdBlockSubscriptionServiceManagerObserver* observer);
   void RemoveObserver(AdBlockSubscriptionServiceManagerObserver* observer);
 
-  void Init(AdBlockResourceProvider* resource_provider);
+  // When |filters_provider_manager| is non-null, enabled subscriptions are
+  // compiled into the merged engine instead of getting a dedicated engine
+  // each.
+  void Init(AdBlockResourceProvider* resource_provider,
+            AdBlockFiltersProviderManager* filters_provider_manager);
   bool IsInitialized();
 
  private:
@@ -132,6 +141,7 @@ class AdBlockSubscriptionServiceManager {
 
   bool initialized_;
   void LoadSubscriptionServices();
+  void StartSubscriptionService(const GURL& sub_url, bool enabled);
   void UpdateSubscriptionPrefs(const GURL& sub_url,
                                const SubscriptionInfo& info);
   void ClearSubscriptionPrefs(const GURL& sub_url);
@@ -139,6 +149,8 @@ class AdBlockSubscriptionServiceManager {
       AdBlockSubscriptionDownloadManager* download_manager);
 
   absl::optional<SubscriptionInfo> GetInfo(const GURL& sub_url);
+  void PublishEnginesSnapshot();
+  scoped_refptr<const AdBlockEngineSnapshot> GetEnginesSnapshot() const;
   void NotifyObserversOfServiceEvent();
 
   void SetUpdateIntervalsForTesting(base::TimeDelta* initial_delay,
@@ -147,14 +159,21 @@ class AdBlockSubscriptionServiceManager {
   raw_ptr<PrefService> local_state_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   raw_ptr<AdBlockResourceProvider> resource_provider_;
+  raw_ptr<AdBlockFiltersProviderManager> filters_provider_manager_ = nullptr;
   raw_ptr<brave_component_updater::BraveComponent::Delegate>
       delegate_;  // NOT OWNED
   base::WeakPtr<AdBlockSubscriptionDownloadManager> download_manager_;
   base::FilePath subscription_path_;
   std::unique_ptr<base::DictionaryValue> subscriptions_;
 
-  std::map<GURL, std::unique_ptr<AdBlockEngine, base::OnTaskRunnerDeleter>>
-      subscription_services_;
+  std::map<GURL, std::shared_ptr<AdBlockEngine>> subscription_services_;
+  // Immutable copy of the engines of enabled subscriptions, republished
+  // whenever the services or their prefs change so that matching never has to
+  // wait on |subscription_services_lock_|. Its own lock is only held to copy
+  // the pointer.
+  mutable base::Lock engines_snapshot_lock_;
+  scoped_refptr<const AdBlockEngineSnapshot> engines_snapshot_
+      GUARDED_BY(engines_snapshot_lock_);
   std::map<GURL, std::unique_ptr<AdBlockSubscriptionFiltersProvider>>
       subscription_filters_providers_;
   std::map<GURL, std::unique_ptr<AdBlockService::SourceProviderObserver>>
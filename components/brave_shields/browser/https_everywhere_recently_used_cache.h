@@ -6,40 +6,107 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/containers/lru_cache.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/synchronization/lock.h"
 
+// The cache is split into shards that each have their own lock, so that
+// lookups for different URLs rarely contend with each other. Eviction is LRU
+// within a shard. Small caches use a single shard, which keeps exact LRU
+// behavior.
 template <class T> class HTTPSERecentlyUsedCache {
  public:
-  explicit HTTPSERecentlyUsedCache(size_t size = 100) : data_(size) {}
+  static constexpr size_t kDefaultShardCount = 8;
+  // Shards are never smaller than this, so that sharding doesn't turn LRU
+  // eviction into near-random eviction.
+  static constexpr size_t kMinShardSize = 16;
+
+  explicit HTTPSERecentlyUsedCache(size_t size = 100,
+                                   size_t shard_count = kDefaultShardCount) {
+    const size_t count =
+        std::max<size_t>(1, std::min(shard_count, size / kMinShardSize));
+    shards_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      // Spread the remainder over the first shards.
+      const size_t shard_size = size / count + (i < size % count ? 1 : 0);
+      shards_.push_back(std::make_unique<Shard>(shard_size));
+    }
+  }
 
   void add(const std::string& key, const T& value) {
-    base::AutoLock create(lock_);
-    data_.Put(key, value);
+    Shard& shard = GetShard(key);
+    bool evicted = false;
+    {
+      base::AutoLock create(shard.lock);
+      evicted = shard.data.Peek(key) == shard.data.end() &&
+                shard.data.size() >= shard.data.max_size();
+      shard.data.Put(key, value);
+    }
+    if (evicted)
+      ++evictions_;
+    UMA_HISTOGRAM_BOOLEAN("Brave.HTTPSE.RecentlyUsedCache.Eviction", evicted);
   }
 
   bool get(const std::string& key, T* value) {
-    base::AutoLock create(lock_);
-    auto it = data_.Get(key);
-    if (it != data_.end()) {
-      *value = it->second;
-      return true;
-    }
-    return false;
+    const bool found = recheck(key, value);
+    if (found)
+      ++hits_;
+    else
+      ++misses_;
+    UMA_HISTOGRAM_BOOLEAN("Brave.HTTPSE.RecentlyUsedCache.Hit", found);
+    return found;
+  }
+
+  // Like get(), but for a key that get() already missed on the same lookup
+  // path, so it isn't counted as another hit or miss.
+  bool recheck(const std::string& key, T* value) {
+    Shard& shard = GetShard(key);
+    base::AutoLock lock(shard.lock);
+    auto it = shard.data.Get(key);
+    if (it == shard.data.end())
+      return false;
+    *value = it->second;
+    return true;
   }
 
   void remove(const std::string& key) {
-    base::AutoLock lock(lock_);
-    auto it = data_.Peek(key);
-    if (it != data_.end())
-      data_.Erase(it);
+    Shard& shard = GetShard(key);
+    base::AutoLock lock(shard.lock);
+    auto it = shard.data.Peek(key);
+    if (it != shard.data.end())
+      shard.data.Erase(it);
   }
 
+  size_t shard_count() const { return shards_.size(); }
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+  size_t evictions() const { return evictions_; }
+
  private:
-  base::LRUCache<std::string, T> data_;
-  base::Lock lock_;
+  struct Shard {
+    explicit Shard(size_t size) : data(size) {}
+
+    base::LRUCache<std::string, T> data;
+    base::Lock lock;
+  };
+
+  Shard& GetShard(const std::string& key) {
+    if (shards_.size() == 1)
+      return *shards_.front();
+    return *shards_[std::hash<std::string>()(key) % shards_.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+  std::atomic<size_t> evictions_{0};
 };
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
@@ -28,3 +28,44 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, Sharding) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+
+  // Small caches aren't sharded.
+  EXPECT_EQ(Cache(3).shard_count(), 1u);
+  EXPECT_EQ(Cache(100, 8).shard_count(), 6u);
+  EXPECT_EQ(Cache(1024, 8).shard_count(), 8u);
+
+  Cache cache(1024, 8);
+  for (int i = 0; i < 64; ++i) {
+    cache.add("k" + std::to_string(i), "v" + std::to_string(i));
+  }
+  std::string v;
+  ASSERT_TRUE(cache.get("k0", &v));
+  ASSERT_STREQ(v.c_str(), "v0");
+  ASSERT_FALSE(cache.get("missing", &v));
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 1u);
+
+  // Rechecking finds the same entries without being counted.
+  ASSERT_TRUE(cache.recheck("k1", &v));
+  ASSERT_STREQ(v.c_str(), "v1");
+  ASSERT_FALSE(cache.recheck("missing", &v));
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, Evictions) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(2);
+
+  cache.add("kA", "vA");
+  cache.add("kB", "vB");
+  // Replacing an existing entry doesn't evict anything.
+  cache.add("kA", "vA2");
+  EXPECT_EQ(cache.evictions(), 0u);
+
+  cache.add("kC", "vC");
+  EXPECT_EQ(cache.evictions(), 1u);
+}
@@ -0,0 +1,143 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/memory/ptr_util.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::string CorrecttoRuleToRE2Engine(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+}  // namespace
+
+HTTPSEverywhereRuleSet::Rule::Rule() = default;
+HTTPSEverywhereRuleSet::Rule::Rule(Rule&&) = default;
+HTTPSEverywhereRuleSet::Rule& HTTPSEverywhereRuleSet::Rule::operator=(
+    Rule&&) = default;
+HTTPSEverywhereRuleSet::Rule::~Rule() = default;
+
+HTTPSEverywhereRuleSet::Target::Target() = default;
+HTTPSEverywhereRuleSet::Target::Target(Target&&) = default;
+HTTPSEverywhereRuleSet::Target& HTTPSEverywhereRuleSet::Target::operator=(
+    Target&&) = default;
+HTTPSEverywhereRuleSet::Target::~Target() = default;
+
+HTTPSEverywhereRuleSet::HTTPSEverywhereRuleSet() = default;
+
+HTTPSEverywhereRuleSet::~HTTPSEverywhereRuleSet() = default;
+
+// static
+std::unique_ptr<HTTPSEverywhereRuleSet> HTTPSEverywhereRuleSet::Parse(
+    const std::string& json) {
+  absl::optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (absl::nullopt == json_object || !json_object->is_list()) {
+    return nullptr;
+  }
+
+  auto rule_set = base::WrapUnique(new HTTPSEverywhereRuleSet());
+  for (const auto& topValue : json_object->GetList()) {
+    const base::Value::Dict* childTopDictionary = topValue.GetIfDict();
+    if (nullptr == childTopDictionary) {
+      continue;
+    }
+
+    Target target;
+    const base::Value::List* eValues = childTopDictionary->FindList("e");
+    if (nullptr != eValues) {
+      for (const auto& eValue : *eValues) {
+        const base::Value::Dict* pDictionary = eValue.GetIfDict();
+        if (nullptr == pDictionary) {
+          continue;
+        }
+        const std::string* pattern = pDictionary->FindString("p");
+        if (!pattern) {
+          continue;
+        }
+        target.exclusions.push_back(
+            std::make_unique<re2::RE2>(CorrecttoRuleToRE2Engine(*pattern)));
+      }
+    }
+
+    const base::Value::List* rValues = childTopDictionary->FindList("r");
+    if (nullptr == rValues) {
+      target.missing_rules = true;
+      rule_set->targets_.push_back(std::move(target));
+      // Nothing after an entry without rules can ever be reached.
+      break;
+    }
+
+    for (const auto& rValue : *rValues) {
+      const base::Value::Dict* pDictionary = rValue.GetIfDict();
+      if (nullptr == pDictionary) {
+        continue;
+      }
+      Rule rule;
+      if (pDictionary->Find("d")) {
+        rule.default_rule = true;
+        target.rules.push_back(std::move(rule));
+        continue;
+      }
+
+      const std::string* from = pDictionary->FindString("f");
+      const std::string* to = pDictionary->FindString("t");
+      if (!from || !to) {
+        continue;
+      }
+      rule.from = std::make_unique<re2::RE2>(*from);
+      rule.to = CorrecttoRuleToRE2Engine(*to);
+      target.rules.push_back(std::move(rule));
+    }
+    rule_set->targets_.push_back(std::move(target));
+  }
+
+  return rule_set;
+}
+
+std::string HTTPSEverywhereRuleSet::Apply(const std::string& url) const {
+  for (const auto& target : targets_) {
+    for (const auto& exclusion : target.exclusions) {
+      if (re2::RE2::FullMatch(url, *exclusion)) {
+        return "";
+      }
+    }
+
+    if (target.missing_rules) {
+      return "";
+    }
+
+    for (const auto& rule : target.rules) {
+      if (rule.default_rule) {
+        std::string newUrl(url);
+        return newUrl.insert(4, "s");
+      }
+
+      std::string newUrl(url);
+      if (re2::RE2::Replace(&newUrl, *rule.from, rule.to) && newUrl != url) {
+        return newUrl;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
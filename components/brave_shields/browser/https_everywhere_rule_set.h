@@ -0,0 +1,68 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// The rules stored for a single domain in the HTTPS Everywhere database,
+// parsed from their JSON form with all regular expressions compiled up front,
+// so that applying them again is only a matter of running RE2.
+class HTTPSEverywhereRuleSet {
+ public:
+  HTTPSEverywhereRuleSet(const HTTPSEverywhereRuleSet&) = delete;
+  HTTPSEverywhereRuleSet& operator=(const HTTPSEverywhereRuleSet&) = delete;
+  ~HTTPSEverywhereRuleSet();
+
+  // Returns nullptr if |json| isn't a list of rule sets.
+  static std::unique_ptr<HTTPSEverywhereRuleSet> Parse(
+      const std::string& json);
+
+  // Returns the HTTPS URL that |url| should be upgraded to, or an empty string
+  // if it shouldn't be.
+  std::string Apply(const std::string& url) const;
+
+ private:
+  struct Rule {
+    Rule();
+    Rule(Rule&&);
+    Rule& operator=(Rule&&);
+    ~Rule();
+
+    // Set when the rule only replaces the http scheme.
+    bool default_rule = false;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct Target {
+    Target();
+    Target(Target&&);
+    Target& operator=(Target&&);
+    ~Target();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // Set when the entry has no valid list of rules, which ends the lookup.
+    bool missing_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSEverywhereRuleSet();
+
+  std::vector<Target> targets_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
@@ -0,0 +1,54 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <memory>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSEverywhereRuleSet;
+
+TEST(HTTPSEverywhereRuleSetTest, InvalidJSON) {
+  EXPECT_FALSE(HTTPSEverywhereRuleSet::Parse("not json"));
+  EXPECT_FALSE(HTTPSEverywhereRuleSet::Parse("{\"r\": []}"));
+}
+
+TEST(HTTPSEverywhereRuleSetTest, DefaultRule) {
+  auto rule_set = HTTPSEverywhereRuleSet::Parse(R"([{"r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/path"),
+            "https://example.com/path");
+}
+
+TEST(HTTPSEverywhereRuleSetTest, RewriteRule) {
+  auto rule_set = HTTPSEverywhereRuleSet::Parse(
+      R"([{"r": [{"f": "^http://www\\.example\\.com/",
+                  "t": "https://secure.example.com/"}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://www.example.com/a"),
+            "https://secure.example.com/a");
+  EXPECT_EQ(rule_set->Apply("http://other.example.com/a"), "");
+  // Applying the same compiled rules again gives the same result.
+  EXPECT_EQ(rule_set->Apply("http://www.example.com/b"),
+            "https://secure.example.com/b");
+}
+
+TEST(HTTPSEverywhereRuleSetTest, Exclusions) {
+  auto rule_set = HTTPSEverywhereRuleSet::Parse(
+      R"([{"e": [{"p": "^http://example\\.com/insecure/.*"}],
+           "r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/insecure/page"), "");
+  EXPECT_EQ(rule_set->Apply("http://example.com/secure/page"),
+            "https://example.com/secure/page");
+}
+
+TEST(HTTPSEverywhereRuleSetTest, MissingRulesEndLookup) {
+  auto rule_set =
+      HTTPSEverywhereRuleSet::Parse(R"([{"e": []}, {"r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/"), "");
+}
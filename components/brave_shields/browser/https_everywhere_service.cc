@@ -12,24 +12,29 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
+#include "base/containers/cxx20_erase.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
 #define DAT_FILE_VERSION "6.0"
-#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
+#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1000
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_RECENTLY_USED_CACHE_SIZE     1024
+#define HTTPSE_COMPILED_RULE_SETS_CACHE_SIZE 1024
 
 namespace {
 
+// How long the redirects made for a request are remembered.
+constexpr base::TimeDelta kRedirectsCountExpiry = base::Minutes(1);
+
 std::vector<std::string> Split(const std::string& s, char delim) {
   std::stringstream ss(s);
   std::string item;
@@ -65,25 +70,18 @@ std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
   }
   return resultDomains;
 }
-std::string leveldbGet(leveldb::DB* db, const std::string &key) {
-  if (!db) {
-    return "";
-  }
-
-  std::string value;
-  leveldb::Status s = db->Get(leveldb::ReadOptions(), key, &value);
-  return s.ok() ? value : "";
-}
 
 }  // namespace
 
 namespace brave_shields {
 
 HTTPSEverywhereService::Engine::Engine(HTTPSEverywhereService* service)
-    : level_db_(nullptr), service_(service) {
+    : rule_sets_(HTTPSE_COMPILED_RULE_SETS_CACHE_SIZE), service_(service) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
+HTTPSEverywhereService::Engine::~Engine() = default;
+
 void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   base::FilePath zip_db_file_path =
@@ -96,18 +94,19 @@ void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir) {
     return;
   }
 
-  CloseDatabase();
+  rule_sets_.Clear();
+  level_db_.reset();
 
+  leveldb::DB* level_db = nullptr;
   leveldb::Options options;
-  leveldb::Status status =
-      leveldb::DB::Open(options,
-                        unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
+  leveldb::Status status = leveldb::DB::Open(
+      options, unzipped_level_db_path.AsUTF8Unsafe(), &level_db);
+  level_db_.reset(level_db);
   if (!status.ok() || !level_db_) {
     LOG(ERROR) << "Level db open error "
                << unzipped_level_db_path.value().c_str()
                << ", error: " << status.ToString();
-    CloseDatabase();
+    level_db_.reset();
     return;
   }
 }
@@ -129,7 +128,9 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
     return false;
   }
 
-  if (service_->recently_used_cache().get(url->spec(), new_url)) {
+  // GetHTTPSURLFromCacheOnly() already recorded the miss that brought the
+  // request here.
+  if (service_->recently_used_cache().recheck(url->spec(), new_url)) {
     service_->AddHTTPSEUrlToRedirectList(request_identifier);
     return true;
   }
@@ -144,10 +145,10 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.HTTPSE.GetHTTPSURL");
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
+  for (const auto& domain : domains) {
+    const HTTPSEverywhereRuleSet* rule_set = GetRuleSet(domain);
+    if (rule_set) {
+      *new_url = rule_set->Apply(candidate_url.spec());
       if (0 != new_url->length()) {
         service_->recently_used_cache().add(candidate_url.spec(), *new_url);
         service_->AddHTTPSEUrlToRedirectList(request_identifier);
@@ -159,108 +160,19 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   return false;
 }
 
-std::string HTTPSEverywhereService::Engine::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  absl::optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (absl::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  const base::Value::List& topValues = json_object->GetList();
-  for (const auto& topValue : topValues) {
-    if (!topValue.is_dict()) {
-      continue;
-    }
-    const base::Value::Dict* childTopDictionary = topValue.GetIfDict();
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = childTopDictionary->Find("e");
-    if (nullptr != exclusion) {
-      const base::Value::List* eValues = exclusion->GetIfList();
-      if (nullptr != eValues) {
-        for (const auto& eValue : *eValues) {
-          const base::Value::Dict* pDictionary = eValue.GetIfDict();
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = pDictionary->Find("p");
-          if (!patternValue) {
-            continue;
-          }
-          if (!patternValue->is_string()) {
-            continue;
-          }
-          std::string pattern =
-              CorrecttoRuleToRE2Engine(patternValue->GetString());
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = childTopDictionary->Find("r");
-    if (!rules) {
-      return "";
-    }
-    const base::Value::List* rValues = rules->GetIfList();
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (const auto& rValue : *rValues) {
-      const base::Value::Dict* pDictionary = rValue.GetIfDict();
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = pDictionary->Find("d");
-      if (patternValue) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = pDictionary->Find("f");
-      const base::Value* to_value = pDictionary->Find("t");
-      if (!from_value || !to_value) {
-        continue;
-      }
-      if (!from_value->is_string() || !to_value->is_string()) {
-        continue;
-      }
-
-      std::string to = CorrecttoRuleToRE2Engine(to_value->GetString());
-      std::string newUrl(originalUrl);
-      RE2 regExp(from_value->GetString());
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::Engine::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
-}
+const HTTPSEverywhereRuleSet* HTTPSEverywhereService::Engine::GetRuleSet(
+    const std::string& key) {
+  auto it = rule_sets_.Get(key);
+  if (it != rule_sets_.end())
+    return it->second.get();
 
-void HTTPSEverywhereService::Engine::CloseDatabase() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
+  std::unique_ptr<HTTPSEverywhereRuleSet> rule_set;
+  std::string value;
+  if (level_db_->Get(leveldb::ReadOptions(), key, &value).ok() &&
+      !value.empty()) {
+    rule_set = HTTPSEverywhereRuleSet::Parse(value);
   }
+  return rule_sets_.Put(key, std::move(rule_set))->second.get();
 }
 
 bool HTTPSEverywhereService::g_ignore_port_for_test_(false);
@@ -268,6 +180,7 @@ bool HTTPSEverywhereService::g_ignore_port_for_test_(false);
 HTTPSEverywhereService::HTTPSEverywhereService(
     scoped_refptr<base::SequencedTaskRunner> task_runner)
     : BaseBraveShieldsService(task_runner),
+      recently_used_cache_(HTTPSE_RECENTLY_USED_CACHE_SIZE),
       engine_(new Engine(this), base::OnTaskRunnerDeleter(task_runner)) {}
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
@@ -315,42 +228,45 @@ HTTPSEverywhereService::recently_used_cache() {
 bool HTTPSEverywhereService::ShouldHTTPSERedirect(
     const uint64_t& request_identifier) {
   base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-            httpse_urls_redirects_count_[i].request_identifier_ &&
-        httpse_urls_redirects_count_[i].redirects_ >=
-            HTTPSE_URL_MAX_REDIRECTS_COUNT - 1) {
-      return false;
-    }
+  auto it = httpse_urls_redirects_count_.find(request_identifier);
+  if (it == httpse_urls_redirects_count_.end())
+    return true;
+
+  if (base::TimeTicks::Now() - it->second.last_redirect >=
+      kRedirectsCountExpiry) {
+    httpse_urls_redirects_count_.erase(it);
+    return true;
   }
 
-  return true;
+  return it->second.redirects < HTTPSE_URL_MAX_REDIRECTS_COUNT - 1;
 }
 
 void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
     const uint64_t& request_identifier) {
   // Adding redirects count for the current request
   base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  bool hostFound = false;
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_) {
-      // Found the host, just increment the redirects_count
-      httpse_urls_redirects_count_[i].redirects_++;
-      hostFound = true;
-      break;
-    }
-  }
-  if (!hostFound) {
-    // The host is new, adding it to the redirects list
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (httpse_urls_redirects_count_.size() >=
+          HTTPSE_URLS_REDIRECTS_COUNT_QUEUE &&
+      !httpse_urls_redirects_count_.count(request_identifier)) {
+    // The map is full, drop the requests that are done redirecting
+    base::EraseIf(httpse_urls_redirects_count_, [now](const auto& entry) {
+      return now - entry.second.last_redirect >= kRedirectsCountExpiry;
+    });
     if (httpse_urls_redirects_count_.size() >=
         HTTPSE_URLS_REDIRECTS_COUNT_QUEUE) {
-      // The queue is full, erase the first element
-      httpse_urls_redirects_count_.erase(httpse_urls_redirects_count_.begin());
+      // Still full, erase the least recently redirected request
+      httpse_urls_redirects_count_.erase(std::min_element(
+          httpse_urls_redirects_count_.begin(),
+          httpse_urls_redirects_count_.end(), [](const auto& a, const auto& b) {
+            return a.second.last_redirect < b.second.last_redirect;
+          }));
     }
-    httpse_urls_redirects_count_.push_back(
-        HTTPSE_REDIRECTS_COUNT_ST(request_identifier, 1));
   }
+
+  RedirectsCount& count = httpse_urls_redirects_count_[request_identifier];
+  count.redirects++;
+  count.last_redirect = now;
 }
 
 // static
@@ -8,12 +8,14 @@
 
 #include <memory>
 #include <string>
-#include <vector>
+#include <unordered_map>
 
+#include "base/containers/lru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 
@@ -27,22 +29,12 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class HTTPSEverywhereRuleSet;
+
 extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
- public:
-  HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-                            unsigned int redirects):
-    request_identifier_(request_identifier),
-    redirects_(redirects) {
-  }
-
-  uint64_t request_identifier_;
-  unsigned int redirects_;
-};
-
 class HTTPSEverywhereService : public BaseBraveShieldsService {
  public:
   explicit HTTPSEverywhereService(
@@ -56,6 +48,7 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
     explicit Engine(HTTPSEverywhereService* service);
     Engine(const Engine&) = delete;
     Engine& operator=(const Engine&) = delete;
+    ~Engine();
 
     void Init(const base::FilePath& base_dir);
     bool GetHTTPSURL(const GURL* url,
@@ -63,12 +56,15 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
                      std::string* new_url);
 
    private:
-    std::string ApplyHTTPSRule(const std::string& originalUrl,
-                               const std::string& rule);
-    std::string CorrecttoRuleToRE2Engine(const std::string& to);
-    void CloseDatabase();
-
-    leveldb::DB* level_db_;
+    // Returns the compiled rule set stored under |key|, a reversed domain
+    // optionally ending with a wildcard, or nullptr if there is none.
+    const HTTPSEverywhereRuleSet* GetRuleSet(const std::string& key);
+
+    std::unique_ptr<leveldb::DB> level_db_;
+    // Rule sets recently looked up, compiled. Keys without rules are cached
+    // too (as nullptr), since most hosts have none.
+    base::LRUCache<std::string, std::unique_ptr<HTTPSEverywhereRuleSet>>
+        rule_sets_;
     HTTPSEverywhereService* service_;  // not owned
     SEQUENCE_CHECKER(sequence_checker_);
   };
@@ -94,8 +90,15 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
   HTTPSERecentlyUsedCache<std::string>& recently_used_cache();
 
+  struct RedirectsCount {
+    unsigned int redirects = 0;
+    base::TimeTicks last_redirect;
+  };
+
   base::Lock httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
+  // Redirects made so far, by request identifier. Entries expire once the
+  // request can no longer be redirecting.
+  std::unordered_map<uint64_t, RedirectsCount> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
   std::unique_ptr<Engine, base::OnTaskRunnerDeleter> engine_;
 
@@ -34,6 +34,12 @@ const base::Feature kBraveAdblockCosmeticFiltering{
     base::FEATURE_ENABLED_BY_DEFAULT};
 const base::Feature kBraveAdblockCspRules{
     "BraveAdblockCspRules", base::FEATURE_ENABLED_BY_DEFAULT};
+// When enabled, regional lists and subscriptions will be compiled into a single
+// adblock engine, instead of one engine each. Regional components that don't
+// ship their list text alongside the serialized DAT keep an engine of their
+// own.
+const base::Feature kBraveAdblockMergedEngine{
+    "BraveAdblockMergedEngine", base::FEATURE_DISABLED_BY_DEFAULT};
 // When enabled, Brave will block domains listed in the user's selected adblock
 // filters and present a security interstitial with choice to proceed and
 // optionally whitelist the domain.
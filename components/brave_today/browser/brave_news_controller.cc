@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/files/file_path.h"
 #include "base/guid.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/time/time.h"
@@ -38,6 +39,17 @@
 
 namespace brave_news {
 
+namespace {
+
+const base::FilePath::CharType kBraveNewsDirName[] =
+    FILE_PATH_LITERAL("Brave News");
+const base::FilePath::CharType kDirectFeedsDirName[] =
+    FILE_PATH_LITERAL("Direct Feeds");
+const base::FilePath::CharType kFeedSnapshotFileName[] =
+    FILE_PATH_LITERAL("Feed Snapshot");
+
+}  // namespace
+
 // static
 void BraveNewsController::RegisterProfilePrefs(PrefRegistrySimple* registry) {
   // Only default brave today to be shown for
@@ -62,6 +74,7 @@ void BraveNewsController::RegisterProfilePrefs(PrefRegistrySimple* registry) {
 }
 
 BraveNewsController::BraveNewsController(
+    const base::FilePath& profile_path,
     PrefService* prefs,
     brave_ads::AdsService* ads_service,
     history::HistoryService* history_service,
@@ -70,11 +83,15 @@ BraveNewsController::BraveNewsController(
       ads_service_(ads_service),
       api_request_helper_(GetNetworkTrafficAnnotationTag(), url_loader_factory),
       publishers_controller_(prefs, &api_request_helper_),
-      direct_feed_controller_(url_loader_factory),
+      direct_feed_controller_(
+          profile_path.Append(kBraveNewsDirName).Append(kDirectFeedsDirName),
+          url_loader_factory),
       feed_controller_(&publishers_controller_,
                        &direct_feed_controller_,
                        history_service,
-                       &api_request_helper_),
+                       &api_request_helper_,
+                       profile_path.Append(kBraveNewsDirName)
+                           .Append(kFeedSnapshotFileName)),
       weak_ptr_factory_(this) {
   DCHECK(prefs);
   // Set up preference listeners
@@ -100,8 +117,10 @@ void BraveNewsController::Bind(
 }
 
 void BraveNewsController::ClearHistory() {
-  // TODO(petemill): Clear history once/if we actually store
-  // feed cache somewhere.
+  // The feed is ranked using browsing history, and direct feeds are
+  // sources the user chose.
+  feed_controller_.ClearCache();
+  direct_feed_controller_.ClearCache();
 }
 
 mojo::PendingRemote<mojom::BraveNewsController>
@@ -194,6 +213,14 @@ void BraveNewsController::SubscribeToNewDirectFeed(
 
 void BraveNewsController::RemoveDirectFeed(const std::string& publisher_id) {
   DictionaryPrefUpdate update(prefs_, prefs::kBraveTodayDirectFeeds);
+  const base::Value* feed = update->FindDictKey(publisher_id);
+  if (feed) {
+    const std::string* source_url =
+        feed->FindStringKey(prefs::kBraveTodayDirectFeedsKeySource);
+    if (source_url) {
+      direct_feed_controller_.RemoveFromCache(GURL(*source_url));
+    }
+  }
   update->RemoveKey(publisher_id);
   // Mark feed as requiring update
   publishers_controller_.EnsurePublishersIsUpdating();
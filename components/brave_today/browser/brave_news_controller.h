@@ -29,6 +29,10 @@
 class PrefRegistrySimple;
 class PrefService;
 
+namespace base {
+class FilePath;
+}  // namespace base
+
 namespace brave_ads {
 class AdsService;
 }  // namespace brave_ads
@@ -49,6 +53,7 @@ class BraveNewsController : public KeyedService,
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
 
   BraveNewsController(
+      const base::FilePath& profile_path,
       PrefService* prefs,
       brave_ads::AdsService* ads_service,
       history::HistoryService* history_service,
@@ -0,0 +1,213 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/direct_feed_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/values.h"
+#include "crypto/sha2.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_news {
+
+namespace {
+
+// Bump when the format of cache files changes, so old files are ignored.
+constexpr int kCacheVersion = 1;
+// Cache files of direct feeds that are much larger than this are not feeds.
+constexpr size_t kMaxCacheFileSize = 10 * 1024 * 1024;
+
+std::string GetString(const base::Value& dict, const char* key) {
+  const std::string* value = dict.FindStringKey(key);
+  return value ? *value : "";
+}
+
+base::Value EntryToValue(const DirectFeedCache::Entry& entry) {
+  base::Value items(base::Value::Type::LIST);
+  for (const auto& feed_item : entry.data.items) {
+    base::Value item(base::Value::Type::DICTIONARY);
+    item.SetStringKey("id", static_cast<std::string>(feed_item.id));
+    item.SetStringKey("title", static_cast<std::string>(feed_item.title));
+    item.SetStringKey("description",
+                      static_cast<std::string>(feed_item.description));
+    item.SetStringKey("image_url",
+                      static_cast<std::string>(feed_item.image_url));
+    item.SetStringKey("destination_url",
+                      static_cast<std::string>(feed_item.destination_url));
+    // base::Value has no 64-bit integers.
+    item.SetStringKey("published_timestamp",
+                      base::NumberToString(feed_item.published_timestamp));
+    items.Append(std::move(item));
+  }
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetIntKey("version", kCacheVersion);
+  value.SetStringKey("etag", entry.etag);
+  value.SetStringKey("last_modified", entry.last_modified);
+  value.SetStringKey("id", static_cast<std::string>(entry.data.id));
+  value.SetStringKey("title", static_cast<std::string>(entry.data.title));
+  value.SetKey("items", std::move(items));
+  return value;
+}
+
+std::unique_ptr<DirectFeedCache::Entry> EntryFromValue(
+    const base::Value& value) {
+  if (!value.is_dict() || value.FindIntKey("version") != kCacheVersion) {
+    return nullptr;
+  }
+  const base::Value* items = value.FindListKey("items");
+  if (!items) {
+    return nullptr;
+  }
+  auto entry = std::make_unique<DirectFeedCache::Entry>();
+  entry->etag = GetString(value, "etag");
+  entry->last_modified = GetString(value, "last_modified");
+  entry->data.id = ::rust::String(GetString(value, "id"));
+  entry->data.title = ::rust::String(GetString(value, "title"));
+  for (const auto& item : items->GetList()) {
+    if (!item.is_dict()) {
+      return nullptr;
+    }
+    FeedItem feed_item;
+    feed_item.id = ::rust::String(GetString(item, "id"));
+    feed_item.title = ::rust::String(GetString(item, "title"));
+    feed_item.description = ::rust::String(GetString(item, "description"));
+    feed_item.image_url = ::rust::String(GetString(item, "image_url"));
+    feed_item.destination_url =
+        ::rust::String(GetString(item, "destination_url"));
+    if (!base::StringToInt64(GetString(item, "published_timestamp"),
+                             &feed_item.published_timestamp)) {
+      return nullptr;
+    }
+    entry->data.items.push_back(std::move(feed_item));
+  }
+  return entry;
+}
+
+std::unique_ptr<DirectFeedCache::Entry> ReadEntry(const base::FilePath& path) {
+  std::string json;
+  if (!base::ReadFileToStringWithMaxSize(path, &json, kMaxCacheFileSize)) {
+    return nullptr;
+  }
+  absl::optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value) {
+    VLOG(1) << "Could not parse direct feed cache file " << path;
+    return nullptr;
+  }
+  return EntryFromValue(*value);
+}
+
+void WriteEntry(const base::FilePath& path,
+                const DirectFeedCache::Entry& entry) {
+  std::string json;
+  if (!base::JSONWriter::Write(EntryToValue(entry), &json)) {
+    return;
+  }
+  if (!base::CreateDirectory(path.DirName())) {
+    VLOG(1) << "Could not create direct feed cache directory";
+    return;
+  }
+  base::ImportantFileWriter::WriteFileAtomically(path, json);
+}
+
+}  // namespace
+
+DirectFeedCache::Entry::Entry() = default;
+DirectFeedCache::Entry::Entry(const Entry&) = default;
+DirectFeedCache::Entry& DirectFeedCache::Entry::operator=(const Entry&) =
+    default;
+DirectFeedCache::Entry::~Entry() = default;
+
+DirectFeedCache::DirectFeedCache(const base::FilePath& cache_dir)
+    : cache_dir_(cache_dir),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+DirectFeedCache::~DirectFeedCache() = default;
+
+void DirectFeedCache::Get(const GURL& feed_url, GetCallback callback) {
+  auto it = entries_.find(feed_url);
+  if (it != entries_.end()) {
+    std::move(callback).Run(it->second.get());
+    return;
+  }
+  // Only read each file once, however many callers are waiting on it.
+  auto& callbacks = pending_reads_[feed_url];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1) {
+    return;
+  }
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&ReadEntry, GetEntryPath(feed_url)),
+      base::BindOnce(&DirectFeedCache::OnEntryRead,
+                     weak_ptr_factory_.GetWeakPtr(), feed_url));
+}
+
+void DirectFeedCache::Put(const GURL& feed_url, std::unique_ptr<Entry> entry) {
+  DCHECK(entry);
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&WriteEntry, GetEntryPath(feed_url), *entry));
+  entries_[feed_url] = std::move(entry);
+}
+
+void DirectFeedCache::Remove(const GURL& feed_url) {
+  entries_[feed_url] = nullptr;
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(base::GetDeleteFileCallback(),
+                                GetEntryPath(feed_url)));
+}
+
+void DirectFeedCache::Clear() {
+  // Pending reads may return what is about to be deleted.
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  auto pending_reads = std::move(pending_reads_);
+  pending_reads_.clear();
+  entries_.clear();
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(base::GetDeletePathRecursivelyCallback(),
+                                cache_dir_));
+  for (auto& pending_read : pending_reads) {
+    for (auto& callback : pending_read.second) {
+      std::move(callback).Run(nullptr);
+    }
+  }
+}
+
+base::FilePath DirectFeedCache::GetEntryPath(const GURL& feed_url) const {
+  const std::string hash = crypto::SHA256HashString(feed_url.spec());
+  return cache_dir_.AppendASCII(base::HexEncode(hash.data(), hash.size()) +
+                                ".json");
+}
+
+void DirectFeedCache::OnEntryRead(const GURL& feed_url,
+                                  std::unique_ptr<Entry> entry) {
+  // Something newer may have been put while the file was being read.
+  if (!entries_.contains(feed_url)) {
+    entries_[feed_url] = std::move(entry);
+  }
+  auto callbacks = std::move(pending_reads_[feed_url]);
+  pending_reads_.erase(feed_url);
+  for (auto& callback : callbacks) {
+    // Look up again each time, since a callback may replace the entry.
+    auto it = entries_.find(feed_url);
+    std::move(callback).Run(it != entries_.end() ? it->second.get() : nullptr);
+  }
+}
+
+}  // namespace brave_news
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_DIRECT_FEED_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_DIRECT_FEED_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback_forward.h"
+#include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/brave_today/rust/lib.rs.h"
+#include "url/gurl.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace brave_news {
+
+// Keeps the last downloaded content of each direct feed along with the
+// validators needed to ask its server whether it has changed since. Each
+// entry is stored in its own file in |cache_dir|, named after a hash of the
+// feed url, and is only read from disk the first time it is asked for. Every
+// entry stays in memory once read, so callers should only put what they use.
+class DirectFeedCache {
+ public:
+  struct Entry {
+    Entry();
+    Entry(const Entry&);
+    Entry& operator=(const Entry&);
+    ~Entry();
+
+    std::string etag;
+    std::string last_modified;
+    FeedData data;
+  };
+
+  // |entry| is nullptr if nothing is cached for the feed. It is only valid
+  // until the callback returns.
+  using GetCallback = base::OnceCallback<void(const Entry* entry)>;
+
+  explicit DirectFeedCache(const base::FilePath& cache_dir);
+  ~DirectFeedCache();
+  DirectFeedCache(const DirectFeedCache&) = delete;
+  DirectFeedCache& operator=(const DirectFeedCache&) = delete;
+
+  void Get(const GURL& feed_url, GetCallback callback);
+  void Put(const GURL& feed_url, std::unique_ptr<Entry> entry);
+  void Remove(const GURL& feed_url);
+  // Forgets every entry and deletes |cache_dir|.
+  void Clear();
+
+ private:
+  base::FilePath GetEntryPath(const GURL& feed_url) const;
+  void OnEntryRead(const GURL& feed_url, std::unique_ptr<Entry> entry);
+
+  base::FilePath cache_dir_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  // A nullptr entry means the feed is known not to be cached.
+  base::flat_map<GURL, std::unique_ptr<Entry>> entries_;
+  base::flat_map<GURL, std::vector<GetCallback>> pending_reads_;
+  base::WeakPtrFactory<DirectFeedCache> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_DIRECT_FEED_CACHE_H_
@@ -0,0 +1,111 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/direct_feed_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_today/rust/lib.rs.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+namespace {
+
+const char kFeedUrl[] = "https://www.example.com/feed.xml";
+
+std::unique_ptr<DirectFeedCache::Entry> MakeEntry() {
+  auto entry = std::make_unique<DirectFeedCache::Entry>();
+  entry->etag = "\"abc\"";
+  entry->last_modified = "Tue, 11 Jan 2022 20:11:52 GMT";
+  entry->data.title = ::rust::String("A Site");
+  FeedItem item;
+  item.id = ::rust::String("1");
+  item.title = ::rust::String("An article");
+  item.destination_url = ::rust::String("https://www.example.com/article");
+  item.published_timestamp = 1641899755;
+  entry->data.items.push_back(item);
+  return entry;
+}
+
+}  // namespace
+
+class DirectFeedCacheTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath GetCacheDir() {
+    return temp_dir_.GetPath().AppendASCII("Direct Feeds");
+  }
+
+  // Returns a copy of the entry for |feed_url|, or nullptr.
+  std::unique_ptr<DirectFeedCache::Entry> Get(DirectFeedCache* cache,
+                                              const GURL& feed_url) {
+    std::unique_ptr<DirectFeedCache::Entry> result;
+    base::RunLoop run_loop;
+    cache->Get(feed_url, base::BindLambdaForTesting(
+                             [&](const DirectFeedCache::Entry* entry) {
+                               if (entry) {
+                                 result = std::make_unique<
+                                     DirectFeedCache::Entry>(*entry);
+                               }
+                               run_loop.Quit();
+                             }));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(DirectFeedCacheTest, PersistsEntries) {
+  {
+    DirectFeedCache cache(GetCacheDir());
+    EXPECT_FALSE(Get(&cache, GURL(kFeedUrl)));
+    cache.Put(GURL(kFeedUrl), MakeEntry());
+    EXPECT_TRUE(Get(&cache, GURL(kFeedUrl)));
+    task_environment_.RunUntilIdle();
+  }
+
+  // A new cache reads what the previous one wrote.
+  DirectFeedCache cache(GetCacheDir());
+  auto entry = Get(&cache, GURL(kFeedUrl));
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(entry->etag, "\"abc\"");
+  EXPECT_EQ(entry->last_modified, "Tue, 11 Jan 2022 20:11:52 GMT");
+  EXPECT_EQ(static_cast<std::string>(entry->data.title), "A Site");
+  ASSERT_EQ(entry->data.items.size(), 1u);
+  EXPECT_EQ(static_cast<std::string>(entry->data.items[0].title),
+            "An article");
+  EXPECT_EQ(static_cast<std::string>(entry->data.items[0].destination_url),
+            "https://www.example.com/article");
+  EXPECT_EQ(entry->data.items[0].published_timestamp, 1641899755);
+  EXPECT_FALSE(Get(&cache, GURL("https://www.example.com/other.xml")));
+}
+
+TEST_F(DirectFeedCacheTest, RemoveAndClear) {
+  DirectFeedCache cache(GetCacheDir());
+  cache.Put(GURL(kFeedUrl), MakeEntry());
+  cache.Remove(GURL(kFeedUrl));
+  EXPECT_FALSE(Get(&cache, GURL(kFeedUrl)));
+
+  cache.Put(GURL(kFeedUrl), MakeEntry());
+  task_environment_.RunUntilIdle();
+  cache.Clear();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(GetCacheDir()));
+  EXPECT_FALSE(Get(&cache, GURL(kFeedUrl)));
+}
+
+}  // namespace brave_news
@@ -12,9 +12,8 @@
 #include <string>
 #include <utility>
 
-#include "base/barrier_callback.h"
+#include "base/barrier_closure.h"
 #include "base/callback.h"
-#include "base/containers/flat_set.h"
 #include "base/logging.h"
 #include "base/time/time.h"
 #include "brave/components/brave_private_cdn/headers.h"
@@ -27,6 +26,8 @@
 #include "components/prefs/pref_service.h"
 #include "net/base/load_flags.h"
 #include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
@@ -37,6 +38,8 @@ namespace brave_news {
 
 namespace {
 
+constexpr base::TimeDelta kFeedDownloadTimeout = base::Seconds(10);
+
 mojom::ArticlePtr RustFeedItemToArticle(const FeedItem& rust_feed_item) {
   // We don't include description since there does not exist a
   // UI which uses that field at the moment.
@@ -64,11 +67,49 @@ mojom::ArticlePtr RustFeedItemToArticle(const FeedItem& rust_feed_item) {
   return article;
 }
 
+Articles ArticlesFromFeedData(const FeedData& data,
+                              const std::string& publisher_id) {
+  Articles articles;
+  for (const auto& entry : data.items) {
+    auto item = RustFeedItemToArticle(entry);
+    item->data->publisher_id = publisher_id;
+    articles.emplace_back(std::move(item));
+    // Limit to a certain count of articles, since for now the content
+    // is only shown in a single combined feed, and the user cannot view
+    // feed items per source.
+    if (articles.size() >= kMaxArticlesPerDirectFeedSource) {
+      break;
+    }
+  }
+  // Add variety to score, same as brave feed aggregator
+  // Sort by score, ascending
+  std::sort(articles.begin(), articles.end(),
+            [](mojom::ArticlePtr& a, mojom::ArticlePtr& b) {
+              return (a.get()->data->score < b.get()->data->score);
+            });
+  double variety = 2.0;
+  for (auto& entry : articles) {
+    entry->data->score = entry->data->score * variety;
+    variety = variety * 2.0;
+  }
+  return articles;
+}
+
 }  // namespace
 
 DirectFeedController::DirectFeedController(
+    const base::FilePath& cache_dir,
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
-    : url_loader_factory_(url_loader_factory) {}
+    : cache_(cache_dir), url_loader_factory_(url_loader_factory) {}
+
+DirectFeedController::DirectFeedController(
+    const base::FilePath& cache_dir,
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+    size_t max_concurrent_fetches,
+    size_t max_concurrent_fetches_per_host)
+    : cache_(cache_dir),
+      scheduler_(max_concurrent_fetches, max_concurrent_fetches_per_host),
+      url_loader_factory_(url_loader_factory) {}
 
 DirectFeedController::~DirectFeedController() = default;
 
@@ -80,146 +121,209 @@ void DirectFeedController::VerifyFeedUrl(const GURL& feed_url,
   // TODO(petemill): Cache for a certain amount of time since user
   // will likely add to their user feed sources. Unless this is already
   // cached via network service?
-  DownloadFeed(feed_url, base::BindOnce(
-                             [](IsValidCallback callback,
-                                std::unique_ptr<DirectFeedResponse> response) {
-                               // Handle response
-                               std::string title = "";
-                               if (response->success) {
-                                 title = response->data.title.c_str();
-                               }
-                               std::move(callback).Run(response->success,
-                                                       title);
-                             },
-                             std::move(callback)));
+  DownloadFeed(feed_url, "", "", DirectFeedFetchScheduler::Priority::kHigh,
+               base::BindOnce(
+                   [](IsValidCallback callback,
+                      std::unique_ptr<DirectFeedResponse> response) {
+                     // Handle response
+                     std::string title = "";
+                     if (response->success) {
+                       title = response->data.title.c_str();
+                     }
+                     std::move(callback).Run(response->success, title);
+                   },
+                   std::move(callback)));
 }
 
 void DirectFeedController::DownloadAllContent(
     std::vector<mojom::PublisherPtr> publishers,
-    GetFeedItemsCallback callback) {
+    FeedItemsReceivedCallback on_feed_items,
+    base::OnceClosure on_done) {
   // Handle when all retrieve operations are complete
-  auto all_done_handler = base::BindOnce(
-      [](GetFeedItemsCallback callback, std::vector<Articles> results) {
-        VLOG(1) << "All direct feeds retrieved.";
-        std::size_t total_size = 0;
-        for (const auto& collection : results) {
-          total_size += collection.size();
-        }
-        std::vector<mojom::FeedItemPtr> all_feed_articles;
-        all_feed_articles.reserve(total_size);
-        for (auto& collection : results) {
-          auto it = collection.begin();
-          while (it != collection.end()) {
-            all_feed_articles.insert(
-                all_feed_articles.end(),
-                mojom::FeedItem::NewArticle(*std::make_move_iterator(it)));
-            it = collection.erase(it);
-          }
-        }
-        std::move(callback).Run(std::move(all_feed_articles));
-      },
-      std::move(callback));
-  // Perform requests in parallel and wait for completion
-  auto feed_content_handler = base::BarrierCallback<Articles>(
-      publishers.size(), std::move(all_done_handler));
-  base::flat_set<GURL> direct_feed_urls;
+  auto feed_done_handler =
+      base::BarrierClosure(publishers.size(), std::move(on_done));
+  // Hand out the articles of each feed as soon as it arrives, so that a slow
+  // feed does not hold up the others.
   for (auto& publisher : publishers) {
     VLOG(1) << "Downloading feed content from "
             << publisher->feed_source.spec();
-    DownloadFeedContent(publisher->feed_source, publisher->publisher_id,
-                        feed_content_handler);
+    DownloadFeedContent(
+        publisher->feed_source, publisher->publisher_id,
+        base::BindOnce(
+            [](FeedItemsReceivedCallback on_feed_items,
+               base::RepeatingClosure feed_done_handler, Articles articles) {
+              if (!articles.empty()) {
+                std::vector<mojom::FeedItemPtr> feed_items;
+                feed_items.reserve(articles.size());
+                for (auto& article : articles) {
+                  feed_items.push_back(
+                      mojom::FeedItem::NewArticle(std::move(article)));
+                }
+                on_feed_items.Run(std::move(feed_items));
+              }
+              feed_done_handler.Run();
+            },
+            on_feed_items, feed_done_handler));
   }
 }
 
+void DirectFeedController::RemoveFromCache(const GURL& feed_url) {
+  cache_.Remove(feed_url);
+}
+
+void DirectFeedController::ClearCache() {
+  cache_.Clear();
+}
+
 void DirectFeedController::DownloadFeedContent(const GURL& feed_url,
                                                const std::string& publisher_id,
                                                GetArticlesCallback callback) {
-  // Handle Data
-  auto responseHandler = base::BindOnce(
-      [](GetArticlesCallback callback, const std::string& publisher_id,
-         std::unique_ptr<DirectFeedResponse> response) {
-        // Validate response
-        if (!response->success) {
-          std::move(callback).Run({});
-          return;
-        }
-        // Valid feed, convert items
-        VLOG(1) << "Valid feed parsed from " << response->url.spec();
-        Articles articles;
-        for (auto entry : response->data.items) {
-          auto item = RustFeedItemToArticle(entry);
-          item->data->publisher_id = publisher_id;
-          articles.emplace_back(std::move(item));
-          // Limit to a certain count of articles, since for now the content
-          // is only shown in a single combined feed, and the user cannot view
-          // feed items per source.
-          if (articles.size() >= kMaxArticlesPerDirectFeedSource) {
-            break;
-          }
-        }
-        // Add variety to score, same as brave feed aggregator
-        // Sort by score, ascending
-        std::sort(articles.begin(), articles.end(),
-                  [](mojom::ArticlePtr& a, mojom::ArticlePtr& b) {
-                    return (a.get()->data->score < b.get()->data->score);
-                  });
-        double variety = 2.0;
-        for (auto& entry : articles) {
-          entry->data->score = entry->data->score * variety;
-          variety = variety * 2.0;
-        }
-        VLOG(1) << "Direct feed retrieved article count: " << articles.size();
-        std::move(callback).Run(std::move(articles));
-      },
-      std::move(callback), publisher_id);
+  // Get the validators of the copy we already have, if any
+  cache_.Get(feed_url,
+             base::BindOnce(&DirectFeedController::OnGetCachedFeed,
+                            base::Unretained(this), feed_url, publisher_id,
+                            std::move(callback)));
+}
+
+void DirectFeedController::OnGetCachedFeed(
+    const GURL& feed_url,
+    const std::string& publisher_id,
+    GetArticlesCallback callback,
+    const DirectFeedCache::Entry* entry) {
+  std::string etag;
+  std::string last_modified;
+  auto priority = DirectFeedFetchScheduler::Priority::kNormal;
+  if (entry) {
+    etag = entry->etag;
+    last_modified = entry->last_modified;
+    priority = DirectFeedFetchScheduler::Priority::kLow;
+  }
   // Make request
-  DownloadFeed(feed_url, std::move(responseHandler));
+  DownloadFeed(feed_url, etag, last_modified, priority,
+               base::BindOnce(&DirectFeedController::OnFeedContentDownloaded,
+                              base::Unretained(this), publisher_id,
+                              std::move(callback)));
 }
 
-void DirectFeedController::DownloadFeed(const GURL& feed_url,
-                                        DownloadFeedCallback callback) {
+void DirectFeedController::OnFeedContentDownloaded(
+    const std::string& publisher_id,
+    GetArticlesCallback callback,
+    std::unique_ptr<DirectFeedResponse> response) {
+  // Feed has not changed, use the cached copy
+  if (response->not_modified) {
+    VLOG(1) << "Direct feed not modified: " << response->url.spec();
+    cache_.Get(response->url,
+               base::BindOnce(
+                   [](const std::string& publisher_id,
+                      GetArticlesCallback callback,
+                      const DirectFeedCache::Entry* entry) {
+                     if (!entry) {
+                       std::move(callback).Run({});
+                       return;
+                     }
+                     std::move(callback).Run(
+                         ArticlesFromFeedData(entry->data, publisher_id));
+                   },
+                   publisher_id, std::move(callback)));
+    return;
+  }
+  // Validate response
+  if (!response->success) {
+    std::move(callback).Run({});
+    return;
+  }
+  // Valid feed, convert items
+  VLOG(1) << "Valid feed parsed from " << response->url.spec();
+  Articles articles = ArticlesFromFeedData(response->data, publisher_id);
+  VLOG(1) << "Direct feed retrieved article count: " << articles.size();
+  auto entry = std::make_unique<DirectFeedCache::Entry>();
+  entry->etag = response->etag;
+  entry->last_modified = response->last_modified;
+  entry->data = std::move(response->data);
+  // Only the items that are turned into articles are worth keeping.
+  entry->data.items.truncate(kMaxArticlesPerDirectFeedSource);
+  cache_.Put(response->url, std::move(entry));
+  std::move(callback).Run(std::move(articles));
+}
+
+void DirectFeedController::DownloadFeed(
+    const GURL& feed_url,
+    const std::string& etag,
+    const std::string& last_modified,
+    DirectFeedFetchScheduler::Priority priority,
+    DownloadFeedCallback callback) {
+  scheduler_.Schedule(
+      feed_url, priority,
+      base::BindOnce(&DirectFeedController::StartDownload,
+                     base::Unretained(this), feed_url, etag, last_modified,
+                     std::move(callback)));
+}
+
+void DirectFeedController::StartDownload(const GURL& feed_url,
+                                         const std::string& etag,
+                                         const std::string& last_modified,
+                                         DownloadFeedCallback callback,
+                                         base::OnceClosure done) {
   // Make request
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = feed_url;
   request->load_flags = net::LOAD_DO_NOT_SAVE_COOKIES;
   request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   request->method = net::HttpRequestHeaders::kGetMethod;
+  if (!etag.empty()) {
+    request->headers.SetHeader(net::HttpRequestHeaders::kIfNoneMatch, etag);
+  }
+  if (!last_modified.empty()) {
+    request->headers.SetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+                               last_modified);
+  }
   auto url_loader = network::SimpleURLLoader::Create(
       std::move(request), GetNetworkTrafficAnnotationTag());
   url_loader->SetRetryOptions(
       1, network::SimpleURLLoader::RetryMode::RETRY_ON_5XX |
              network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE);
   url_loader->SetAllowHttpErrorResults(true);
+  // Don't let an unresponsive server hold on to a slot of the scheduler.
+  url_loader->SetTimeoutDuration(kFeedDownloadTimeout);
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
   iter->get()->DownloadToString(
       url_loader_factory_.get(),
       // Handle response
       base::BindOnce(&DirectFeedController::OnResponse, base::Unretained(this),
-                     iter, std::move(callback), feed_url),
+                     iter, std::move(callback), std::move(done), feed_url),
       5 * 1024 * 1024);
 }
 
 void DirectFeedController::OnResponse(
     SimpleURLLoaderList::iterator iter,
     DownloadFeedCallback callback,
+    base::OnceClosure done,
     const GURL& feed_url,
     const std::unique_ptr<std::string> response_body) {
   // Parse response data
   auto* loader = iter->get();
   auto response_code = -1;
-  base::flat_map<std::string, std::string> headers;
+  auto result = std::make_unique<DirectFeedResponse>(DirectFeedResponse());
   if (loader->ResponseInfo()) {
     auto headers_list = loader->ResponseInfo()->headers;
     if (headers_list) {
       response_code = headers_list->response_code();
+      headers_list->EnumerateHeader(nullptr, "ETag", &result->etag);
+      headers_list->EnumerateHeader(nullptr, "Last-Modified",
+                                    &result->last_modified);
     }
   }
   url_loaders_.erase(iter);
+  std::move(done).Run();
   // Validate if we get a feed
   std::string body_content = response_body ? *response_body : "";
   // TODO(petemill): handle any url redirects and change the stored feed url?
-  auto result = std::make_unique<DirectFeedResponse>(DirectFeedResponse());
   result->url = feed_url;
+  if (response_code == net::HTTP_NOT_MODIFIED) {
+    result->not_modified = true;
+    std::move(callback).Run(std::move(result));
+    return;
+  }
   if (response_code < 200 || response_code >= 300 || body_content.empty()) {
     VLOG(1) << feed_url.spec()
             << " invalid response, status: " << response_code;
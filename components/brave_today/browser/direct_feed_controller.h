@@ -13,10 +13,16 @@
 
 #include "base/callback_forward.h"
 #include "base/memory/scoped_refptr.h"
+#include "brave/components/brave_today/browser/direct_feed_cache.h"
+#include "brave/components/brave_today/browser/direct_feed_fetch_scheduler.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/rust/lib.rs.h"
 #include "url/gurl.h"
 
+namespace base {
+class FilePath;
+}  // namespace base
+
 class PrefService;
 
 namespace network {
@@ -33,12 +39,17 @@ struct DirectFeedResponse {
   FeedData data;
   GURL url;
   bool success = false;
+  // The server says the feed has not changed since the copy identified by
+  // the validators that were sent.
+  bool not_modified = false;
+  std::string etag;
+  std::string last_modified;
 };
 
 using Articles = std::vector<mojom::ArticlePtr>;
 using GetArticlesCallback = base::OnceCallback<void(Articles)>;
-using GetFeedItemsCallback =
-    base::OnceCallback<void(std::vector<mojom::FeedItemPtr>)>;
+using FeedItemsReceivedCallback =
+    base::RepeatingCallback<void(std::vector<mojom::FeedItemPtr>)>;
 using DownloadFeedCallback =
     base::OnceCallback<void(std::unique_ptr<DirectFeedResponse>)>;
 using IsValidCallback =
@@ -48,15 +59,31 @@ using IsValidCallback =
 // directly from the feed source server.
 class DirectFeedController {
  public:
-  explicit DirectFeedController(
+  // Downloaded feeds are cached in |cache_dir|, so that they only have to be
+  // downloaded again once their server says they changed.
+  DirectFeedController(
+      const base::FilePath& cache_dir,
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+  // Exposed for testing, to use other download limits.
+  DirectFeedController(
+      const base::FilePath& cache_dir,
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+      size_t max_concurrent_fetches,
+      size_t max_concurrent_fetches_per_host);
   ~DirectFeedController();
   DirectFeedController(const DirectFeedController&) = delete;
   DirectFeedController& operator=(const DirectFeedController&) = delete;
 
   void VerifyFeedUrl(const GURL& feed_url, IsValidCallback callback);
+  // Downloads the feeds of |publishers|, a few at a time. |on_feed_items| is
+  // run with the articles of each feed as soon as it has been downloaded, and
+  // |on_done| once every feed has been downloaded or has failed.
   void DownloadAllContent(std::vector<mojom::PublisherPtr> publishers,
-                          GetFeedItemsCallback callback);
+                          FeedItemsReceivedCallback on_feed_items,
+                          base::OnceClosure on_done);
+  // Forgets the cached content of the feed at |feed_url|.
+  void RemoveFromCache(const GURL& feed_url);
+  void ClearCache();
 
  private:
   using SimpleURLLoaderList =
@@ -64,12 +91,33 @@ class DirectFeedController {
   void DownloadFeedContent(const GURL& feed_url,
                            const std::string& publisher_id,
                            GetArticlesCallback callback);
-  void DownloadFeed(const GURL& feed_url, DownloadFeedCallback callback);
+  void OnGetCachedFeed(const GURL& feed_url,
+                       const std::string& publisher_id,
+                       GetArticlesCallback callback,
+                       const DirectFeedCache::Entry* entry);
+  void OnFeedContentDownloaded(const std::string& publisher_id,
+                               GetArticlesCallback callback,
+                               std::unique_ptr<DirectFeedResponse> response);
+  // Sends |etag| and |last_modified|, when not empty, so that the server can
+  // answer with a 304 if the feed has not changed.
+  void DownloadFeed(const GURL& feed_url,
+                    const std::string& etag,
+                    const std::string& last_modified,
+                    DirectFeedFetchScheduler::Priority priority,
+                    DownloadFeedCallback callback);
+  void StartDownload(const GURL& feed_url,
+                     const std::string& etag,
+                     const std::string& last_modified,
+                     DownloadFeedCallback callback,
+                     base::OnceClosure done);
   void OnResponse(SimpleURLLoaderList::iterator iter,
                   DownloadFeedCallback callback,
+                  base::OnceClosure done,
                   const GURL& feed_url,
                   const std::unique_ptr<std::string> response_body);
 
+  DirectFeedCache cache_;
+  DirectFeedFetchScheduler scheduler_;
   SimpleURLLoaderList url_loaders_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
 };
@@ -3,17 +3,35 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this file,
 // you can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include "brave/components/brave_today/browser/direct_feed_controller.h"
+
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/logging.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "brave/components/brave_today/rust/lib.rs.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "services/network/test/test_shared_url_loader_factory.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
 
 namespace brave_news {
 
@@ -103,8 +121,129 @@ std::string GetFeedJson() {
       </rss>)";
 }
 
+constexpr int kBenchmarkFeedCount = 30;
+constexpr int kBenchmarkArticlesPerFeed = 5;
+
+// Every tenth feed is slow to respond.
+base::TimeDelta GetBenchmarkFeedDelay(int feed_index) {
+  return feed_index % 10 == 9 ? base::Milliseconds(300)
+                              : base::Milliseconds(20);
+}
+
+std::string GetBenchmarkFeedXml(int feed_index) {
+  std::string items;
+  for (int i = 0; i < kBenchmarkArticlesPerFeed; i++) {
+    items += base::StringPrintf(
+        "<item><title>Article %d of feed %d</title>"
+        "<link>https://www.example.com/%d/%d</link>"
+        "<pubDate>Tue, 11 Jan 2022 11:15:55 GMT</pubDate></item>",
+        i, feed_index, feed_index, i);
+  }
+  return base::StringPrintf(
+      "<?xml version=\"1.0\" encoding=\"utf-8\"?><rss version=\"2.0\">"
+      "<channel><title>Feed %d</title>%s</channel></rss>",
+      feed_index, items.c_str());
+}
+
+// Serves /feed/<n> after the delay of feed <n>.
+std::unique_ptr<net::test_server::HttpResponse> HandleBenchmarkFeedRequest(
+    const net::test_server::HttpRequest& request) {
+  int feed_index;
+  if (!base::StartsWith(request.relative_url, "/feed/") ||
+      !base::StringToInt(request.relative_url.substr(6), &feed_index)) {
+    return nullptr;
+  }
+  auto response = std::make_unique<net::test_server::DelayedHttpResponse>(
+      GetBenchmarkFeedDelay(feed_index));
+  response->set_content_type("application/rss+xml");
+  response->set_content(GetBenchmarkFeedXml(feed_index));
+  return response;
+}
+
 }  // namespace
 
+// Measures how long it takes for the first articles, and for all of them, to
+// arrive from feeds served by a local server, some of which are slow. The
+// timings depend on the machine, so the tests only run with --run-manual.
+class BraveNewsDirectFeedBenchmark : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    test_server_.RegisterRequestHandler(
+        base::BindRepeating(&HandleBenchmarkFeedRequest));
+    ASSERT_TRUE(test_server_.Start());
+  }
+
+  void TearDown() override {
+    // Let the cache finish writing to |temp_dir_| before it is deleted.
+    task_environment_.RunUntilIdle();
+  }
+
+  void RunBenchmark(const std::string& story,
+                    size_t max_concurrent_fetches,
+                    size_t max_concurrent_fetches_per_host) {
+    DirectFeedController controller(
+        temp_dir_.GetPath().AppendASCII(story),
+        base::MakeRefCounted<network::TestSharedURLLoaderFactory>(),
+        max_concurrent_fetches, max_concurrent_fetches_per_host);
+    std::vector<mojom::PublisherPtr> publishers;
+    for (int i = 0; i < kBenchmarkFeedCount; i++) {
+      auto publisher = mojom::Publisher::New();
+      publisher->publisher_id = base::NumberToString(i);
+      publisher->type = mojom::PublisherType::DIRECT_SOURCE;
+      publisher->feed_source =
+          test_server_.GetURL("/feed/" + base::NumberToString(i));
+      publishers.push_back(std::move(publisher));
+    }
+
+    base::ElapsedTimer timer;
+    base::TimeDelta time_to_first_article;
+    size_t article_count = 0;
+    base::RunLoop run_loop;
+    controller.DownloadAllContent(
+        std::move(publishers),
+        base::BindLambdaForTesting(
+            [&](std::vector<mojom::FeedItemPtr> feed_items) {
+              if (article_count == 0) {
+                time_to_first_article = timer.Elapsed();
+              }
+              article_count += feed_items.size();
+            }),
+        run_loop.QuitClosure());
+    run_loop.Run();
+    base::TimeDelta time_to_complete = timer.Elapsed();
+
+    EXPECT_EQ(article_count, static_cast<size_t>(kBenchmarkFeedCount *
+                                                 kBenchmarkArticlesPerFeed));
+
+    perf_test::PerfResultReporter reporter("BraveNewsDirectFeed.", story);
+    reporter.RegisterImportantMetric(".time_to_first_article", "ms");
+    reporter.RegisterImportantMetric(".time_to_complete", "ms");
+    reporter.AddResult(".time_to_first_article", time_to_first_article);
+    reporter.AddResult(".time_to_complete", time_to_complete);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::MainThreadType::IO};
+  base::ScopedTempDir temp_dir_;
+  net::EmbeddedTestServer test_server_;
+};
+
+TEST_F(BraveNewsDirectFeedBenchmark, MANUAL_DefaultLimits) {
+  RunBenchmark("default_limits",
+               DirectFeedFetchScheduler::kMaxConcurrentFetches,
+               DirectFeedFetchScheduler::kMaxConcurrentFetchesPerHost);
+}
+
+// All feeds share the host of the local server, so lift the per host limit
+// to see the effect of the overall one.
+TEST_F(BraveNewsDirectFeedBenchmark, MANUAL_OverallLimitOnly) {
+  RunBenchmark("overall_limit_only",
+               DirectFeedFetchScheduler::kMaxConcurrentFetches,
+               DirectFeedFetchScheduler::kMaxConcurrentFetches);
+}
+
 TEST(BraveNewsDirectFeed, ParseFeed) {
   FeedData data;
   // If this errors, probably our xml was not valid
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/direct_feed_fetch_scheduler.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/check_op.h"
+
+namespace brave_news {
+
+DirectFeedFetchScheduler::PendingFetch::PendingFetch(std::string host,
+                                                     Priority priority,
+                                                     FetchCallback fetch)
+    : host(std::move(host)), priority(priority), fetch(std::move(fetch)) {}
+
+DirectFeedFetchScheduler::PendingFetch::PendingFetch(PendingFetch&&) = default;
+
+DirectFeedFetchScheduler::PendingFetch&
+DirectFeedFetchScheduler::PendingFetch::operator=(PendingFetch&&) = default;
+
+DirectFeedFetchScheduler::PendingFetch::~PendingFetch() = default;
+
+DirectFeedFetchScheduler::DirectFeedFetchScheduler(
+    size_t max_concurrent_fetches,
+    size_t max_concurrent_fetches_per_host)
+    : max_concurrent_fetches_(max_concurrent_fetches),
+      max_concurrent_fetches_per_host_(max_concurrent_fetches_per_host) {
+  DCHECK_GT(max_concurrent_fetches_, 0u);
+  DCHECK_GT(max_concurrent_fetches_per_host_, 0u);
+}
+
+DirectFeedFetchScheduler::~DirectFeedFetchScheduler() = default;
+
+void DirectFeedFetchScheduler::Schedule(const GURL& url,
+                                        Priority priority,
+                                        FetchCallback fetch) {
+  // Insert after every fetch of the same or a higher priority.
+  auto it = pending_.begin();
+  while (it != pending_.end() && it->priority <= priority) {
+    it++;
+  }
+  pending_.emplace(it, url.host(), priority, std::move(fetch));
+  StartFetches();
+}
+
+void DirectFeedFetchScheduler::StartFetches() {
+  // Take everything that can start before running any of it, as a fetch may
+  // finish, and so get here again, before it returns.
+  std::vector<PendingFetch> fetches;
+  auto it = pending_.begin();
+  while (it != pending_.end() && active_count_ < max_concurrent_fetches_) {
+    size_t& host_count = active_count_per_host_[it->host];
+    if (host_count >= max_concurrent_fetches_per_host_) {
+      it++;
+      continue;
+    }
+    host_count++;
+    active_count_++;
+    fetches.push_back(std::move(*it));
+    it = pending_.erase(it);
+  }
+  for (auto& fetch : fetches) {
+    std::move(fetch.fetch)
+        .Run(base::BindOnce(&DirectFeedFetchScheduler::OnFetchDone,
+                            weak_ptr_factory_.GetWeakPtr(), fetch.host));
+  }
+}
+
+void DirectFeedFetchScheduler::OnFetchDone(const std::string& host) {
+  DCHECK_GT(active_count_, 0u);
+  DCHECK_GT(active_count_per_host_[host], 0u);
+  active_count_--;
+  if (--active_count_per_host_[host] == 0) {
+    active_count_per_host_.erase(host);
+  }
+  StartFetches();
+}
+
+}  // namespace brave_news
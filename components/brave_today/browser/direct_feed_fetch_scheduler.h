@@ -0,0 +1,80 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_DIRECT_FEED_FETCH_SCHEDULER_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_DIRECT_FEED_FETCH_SCHEDULER_H_
+
+#include <stddef.h>
+
+#include <list>
+#include <string>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+// Limits how many direct feeds are downloaded at once, overall and per host,
+// and starts queued downloads in order of priority, then of scheduling.
+class DirectFeedFetchScheduler {
+ public:
+  static constexpr size_t kMaxConcurrentFetches = 6;
+  static constexpr size_t kMaxConcurrentFetchesPerHost = 2;
+
+  enum class Priority {
+    // Someone is waiting on the result, e.g. to subscribe to the feed.
+    kHigh,
+    // Feeds we have nothing to show for yet.
+    kNormal,
+    // Feeds we already have a copy of, which most likely has not changed.
+    kLow,
+  };
+
+  // Starts a download, and must run |done| once it has finished or failed.
+  using FetchCallback = base::OnceCallback<void(base::OnceClosure done)>;
+
+  DirectFeedFetchScheduler(
+      size_t max_concurrent_fetches = kMaxConcurrentFetches,
+      size_t max_concurrent_fetches_per_host = kMaxConcurrentFetchesPerHost);
+  ~DirectFeedFetchScheduler();
+  DirectFeedFetchScheduler(const DirectFeedFetchScheduler&) = delete;
+  DirectFeedFetchScheduler& operator=(const DirectFeedFetchScheduler&) =
+      delete;
+
+  // Runs |fetch| as soon as the limits allow for a download from |url|.
+  void Schedule(const GURL& url, Priority priority, FetchCallback fetch);
+
+  size_t active_count() const { return active_count_; }
+  size_t pending_count() const { return pending_.size(); }
+
+ private:
+  struct PendingFetch {
+    PendingFetch(std::string host, Priority priority, FetchCallback fetch);
+    PendingFetch(PendingFetch&&);
+    PendingFetch& operator=(PendingFetch&&);
+    ~PendingFetch();
+
+    std::string host;
+    Priority priority;
+    FetchCallback fetch;
+  };
+
+  void StartFetches();
+  void OnFetchDone(const std::string& host);
+
+  const size_t max_concurrent_fetches_;
+  const size_t max_concurrent_fetches_per_host_;
+  size_t active_count_ = 0;
+  base::flat_map<std::string, size_t> active_count_per_host_;
+  // Sorted by priority, and by order of scheduling within a priority.
+  std::list<PendingFetch> pending_;
+  base::WeakPtrFactory<DirectFeedFetchScheduler> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_DIRECT_FEED_FETCH_SCHEDULER_H_
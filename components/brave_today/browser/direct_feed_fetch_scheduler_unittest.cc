@@ -0,0 +1,105 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/direct_feed_fetch_scheduler.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+namespace {
+
+using Priority = DirectFeedFetchScheduler::Priority;
+
+// Records which fetches were started, and holds on to their |done| closures.
+class FetchRecorder {
+ public:
+  DirectFeedFetchScheduler::FetchCallback Fetch(const std::string& name) {
+    return base::BindOnce(&FetchRecorder::OnFetch, base::Unretained(this),
+                          name);
+  }
+
+  void Finish(size_t index) { std::move(done_[index]).Run(); }
+
+  const std::vector<std::string>& started() const { return started_; }
+
+ private:
+  void OnFetch(const std::string& name, base::OnceClosure done) {
+    started_.push_back(name);
+    done_.push_back(std::move(done));
+  }
+
+  std::vector<std::string> started_;
+  std::vector<base::OnceClosure> done_;
+};
+
+}  // namespace
+
+TEST(BraveNewsDirectFeedFetchScheduler, LimitsConcurrentFetches) {
+  DirectFeedFetchScheduler scheduler(2, 2);
+  FetchRecorder recorder;
+  scheduler.Schedule(GURL("https://a.com/feed"), Priority::kNormal,
+                     recorder.Fetch("a"));
+  scheduler.Schedule(GURL("https://b.com/feed"), Priority::kNormal,
+                     recorder.Fetch("b"));
+  scheduler.Schedule(GURL("https://c.com/feed"), Priority::kNormal,
+                     recorder.Fetch("c"));
+  EXPECT_EQ(recorder.started(), std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(scheduler.active_count(), 2u);
+  EXPECT_EQ(scheduler.pending_count(), 1u);
+
+  recorder.Finish(1);
+  EXPECT_EQ(recorder.started(), std::vector<std::string>({"a", "b", "c"}));
+  EXPECT_EQ(scheduler.active_count(), 2u);
+  EXPECT_EQ(scheduler.pending_count(), 0u);
+
+  recorder.Finish(0);
+  recorder.Finish(2);
+  EXPECT_EQ(scheduler.active_count(), 0u);
+}
+
+TEST(BraveNewsDirectFeedFetchScheduler, LimitsConcurrentFetchesPerHost) {
+  DirectFeedFetchScheduler scheduler(4, 1);
+  FetchRecorder recorder;
+  scheduler.Schedule(GURL("https://a.com/1"), Priority::kNormal,
+                     recorder.Fetch("a1"));
+  scheduler.Schedule(GURL("https://a.com/2"), Priority::kNormal,
+                     recorder.Fetch("a2"));
+  // Not held up by the fetch waiting on a.com.
+  scheduler.Schedule(GURL("https://b.com/1"), Priority::kNormal,
+                     recorder.Fetch("b1"));
+  EXPECT_EQ(recorder.started(), std::vector<std::string>({"a1", "b1"}));
+
+  recorder.Finish(0);
+  EXPECT_EQ(recorder.started(), std::vector<std::string>({"a1", "b1", "a2"}));
+}
+
+TEST(BraveNewsDirectFeedFetchScheduler, StartsHigherPriorityFirst) {
+  DirectFeedFetchScheduler scheduler(1, 1);
+  FetchRecorder recorder;
+  scheduler.Schedule(GURL("https://a.com/feed"), Priority::kNormal,
+                     recorder.Fetch("first"));
+  scheduler.Schedule(GURL("https://b.com/feed"), Priority::kLow,
+                     recorder.Fetch("low"));
+  scheduler.Schedule(GURL("https://c.com/feed"), Priority::kNormal,
+                     recorder.Fetch("normal"));
+  scheduler.Schedule(GURL("https://d.com/feed"), Priority::kHigh,
+                     recorder.Fetch("high"));
+
+  for (size_t i = 0; i < 4; i++) {
+    recorder.Finish(i);
+  }
+  EXPECT_EQ(recorder.started(), std::vector<std::string>(
+                                    {"first", "high", "normal", "low"}));
+}
+
+}  // namespace brave_news
@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/contains.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
@@ -223,44 +224,16 @@ mojom::FeedItemMetadataPtr& MetadataFromFeedItem(
   }
 }
 
-}  // namespace
-
-bool ShouldDisplayFeedItem(const mojom::FeedItemPtr& feed_item,
-                           const Publishers* publishers) {
-  // Filter out articles from publishers we're ignoring
-  const auto& data = MetadataFromFeedItem(feed_item);
-  if (!publishers->contains(data->publisher_id)) {
-    VLOG(1) << "Found article with unknown publisher_id. PublisherId: "
-            << data->publisher_id;
-    return false;
-  }
-  const auto& publisher = publishers->at(data->publisher_id);
-  if (publisher->user_enabled_status ==
-      brave_news::mojom::UserEnabled::DISABLED) {
-    VLOG(1) << "Hiding article for disabled-by-user publisher "
-            << data->publisher_id << ": " << publisher->publisher_name;
-    return false;
-  }
-  if (publisher->user_enabled_status ==
-          brave_news::mojom::UserEnabled::NOT_MODIFIED &&
-      publisher->is_enabled == false) {
-    VLOG(2) << "Hiding article for disabled-by-default publisher "
-            << data->publisher_id << ": " << publisher->publisher_name;
-    return false;
-  }
-  // None of the filters match, we can display
-  VLOG(2) << "None of the filters matched, will display item for publisher "
-          << data->publisher_id;
-  return true;
-}
-
-bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
-               const std::unordered_set<std::string>& history_hosts,
-               Publishers* publishers,
-               mojom::Feed* feed) {
-  std::list<mojom::ArticlePtr> articles;
-  std::list<mojom::PromotedArticlePtr> promoted_articles;
-  std::list<mojom::DealPtr> deals;
+// Moves the items of |feed_items| that should be displayed into a list per
+// type, and returns the hash of the feed they make up.
+std::string CollectFeedItems(
+    const std::vector<mojom::FeedItemPtr>& feed_items,
+    const std::unordered_set<std::string>& history_hosts,
+    Publishers* publishers,
+    std::list<mojom::ArticlePtr>* articles,
+    std::list<mojom::PromotedArticlePtr>* promoted_articles,
+    std::list<mojom::DealPtr>* deals) {
+  std::string hash;
   std::hash<std::string> hasher;
   for (auto& item : feed_items) {
     if (!ShouldDisplayFeedItem(item, publishers)) {
@@ -285,19 +258,35 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
     // Get hash at this point since we have a flat list, and our algorithm
     // will only change sorting which can be re-applied on the next
     // feed update.
-    feed->hash = std::to_string(hasher(feed->hash + metadata->url.spec()));
+    hash = std::to_string(hasher(hash + metadata->url.spec()));
     switch (item->which()) {
       case mojom::FeedItem::Tag::kArticle:
-        articles.push_back(std::move(item->get_article()));
+        articles->push_back(std::move(item->get_article()));
         break;
       case mojom::FeedItem::Tag::kDeal:
-        deals.push_back(std::move(item->get_deal()));
+        deals->push_back(std::move(item->get_deal()));
         break;
       case mojom::FeedItem::Tag::kPromotedArticle:
-        promoted_articles.push_back(std::move(item->get_promoted_article()));
+        promoted_articles->push_back(
+            std::move(item->get_promoted_article()));
         break;
     }
   }
+  return hash;
+}
+
+// Appends pages made from the given items to |feed|, numbering them from
+// |first_page|. The categories in |used_category_names| and
+// |used_deal_category_names| were already given a page by the pages before
+// |first_page|, so are not given another.
+void BuildFeedPages(
+    std::list<mojom::ArticlePtr> articles,
+    std::list<mojom::PromotedArticlePtr> promoted_articles,
+    std::list<mojom::DealPtr> deals,
+    size_t first_page,
+    const std::unordered_set<std::string>& used_category_names,
+    const std::unordered_set<std::string>& used_deal_category_names,
+    mojom::Feed* feed) {
   VLOG(1) << "Got articles # " << articles.size();
   VLOG(1) << "Got deals # " << deals.size();
   VLOG(1) << "Got promoted articles # " << promoted_articles.size();
@@ -326,8 +315,10 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
   for (auto kv : category_counts) {
     // Top News is always first category
     // TODO(petemill): handle translated version in non-english feeds
-    if (kv.first != "Top News")
+    if (kv.first != "Top News" &&
+        !base::Contains(used_category_names, kv.first)) {
       category_names_by_priority.emplace_back(kv.first);
+    }
   }
   std::sort(category_names_by_priority.begin(),
             category_names_by_priority.end(),
@@ -335,8 +326,10 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
               return (category_counts.at(a) < category_counts.at(b));
             });
   // Top News is always first category
-  category_names_by_priority.insert(category_names_by_priority.begin(),
-                                    "Top News");
+  if (!base::Contains(used_category_names, "Top News")) {
+    category_names_by_priority.insert(category_names_by_priority.begin(),
+                                      "Top News");
+  }
   VLOG(1) << "Got categories # " << category_names_by_priority.size();
   // Get unique deals categories present
   std::map<std::string, std::int32_t> deal_category_counts;
@@ -350,7 +343,8 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
   // Ordered by # of occurrences
   std::vector<std::string> deal_category_names_by_priority;
   for (auto kv : deal_category_counts) {
-    deal_category_names_by_priority.emplace_back(kv.first);
+    if (!base::Contains(used_deal_category_names, kv.first))
+      deal_category_names_by_priority.emplace_back(kv.first);
   }
   std::sort(deal_category_names_by_priority.begin(),
             deal_category_names_by_priority.end(),
@@ -358,24 +352,27 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
               return (deal_category_counts.at(a) < deal_category_counts.at(b));
             });
   VLOG(1) << "Got deal categories # " << deal_category_names_by_priority.size();
-  // Get first headline
-  std::list<mojom::ArticlePtr>::iterator featured_article_it;
-  for (featured_article_it = articles.begin();
-       featured_article_it != articles.end(); featured_article_it++) {
-    if (featured_article_it->get()->data->category_name == "Top News") {
-      break;
+  // Get first headline, unless a previous build already featured one
+  if (!feed->featured_item) {
+    std::list<mojom::ArticlePtr>::iterator featured_article_it;
+    for (featured_article_it = articles.begin();
+         featured_article_it != articles.end(); featured_article_it++) {
+      if (featured_article_it->get()->data->category_name == "Top News") {
+        break;
+      }
+    }
+    if (featured_article_it != articles.end()) {
+      auto item = *std::make_move_iterator(featured_article_it);
+      auto article = mojom::FeedItem::NewArticle(std::move(item));
+      feed->featured_item = std::move(article);
+      articles.erase(featured_article_it);
     }
   }
-  if (featured_article_it != articles.end()) {
-    auto item = *std::make_move_iterator(featured_article_it);
-    auto article = mojom::FeedItem::NewArticle(std::move(item));
-    feed->featured_item = std::move(article);
-    articles.erase(featured_article_it);
-  }
+
   // Generate as many pages of content as possible
   // Make the pages
-  int cur_page = 0;
-  const int max_pages = 4000;
+  size_t cur_page = first_page;
+  const size_t max_pages = 4000;
   auto category_it = category_names_by_priority.begin();
   auto deal_category_it = deal_category_names_by_priority.begin();
   while (cur_page++ < max_pages) {
@@ -415,6 +412,196 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
     }
   }
   VLOG(1) << "Made pages # " << feed->pages.size();
+}
+
+void AddItemUrl(const mojom::FeedItemPtr& item,
+                std::unordered_set<std::string>* urls) {
+  urls->insert(MetadataFromFeedItem(item)->url.spec());
+}
+
+template <class T>
+void RemoveItemsWithUrls(const std::unordered_set<std::string>& urls,
+                         std::list<mojo::StructPtr<T>>* items) {
+  items->remove_if([&urls](const mojo::StructPtr<T>& item) {
+    return urls.find(item->data->url.spec()) != urls.end();
+  });
+}
+
+}  // namespace
+
+bool ShouldDisplayFeedItem(const mojom::FeedItemPtr& feed_item,
+                           const Publishers* publishers) {
+  // Filter out articles from publishers we're ignoring
+  const auto& data = MetadataFromFeedItem(feed_item);
+  if (!publishers->contains(data->publisher_id)) {
+    VLOG(1) << "Found article with unknown publisher_id. PublisherId: "
+            << data->publisher_id;
+    return false;
+  }
+  const auto& publisher = publishers->at(data->publisher_id);
+  if (publisher->user_enabled_status ==
+      brave_news::mojom::UserEnabled::DISABLED) {
+    VLOG(1) << "Hiding article for disabled-by-user publisher "
+            << data->publisher_id << ": " << publisher->publisher_name;
+    return false;
+  }
+  if (publisher->user_enabled_status ==
+          brave_news::mojom::UserEnabled::NOT_MODIFIED &&
+      publisher->is_enabled == false) {
+    VLOG(2) << "Hiding article for disabled-by-default publisher "
+            << data->publisher_id << ": " << publisher->publisher_name;
+    return false;
+  }
+  // None of the filters match, we can display
+  VLOG(2) << "None of the filters matched, will display item for publisher "
+          << data->publisher_id;
+  return true;
+}
+
+bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
+               const std::unordered_set<std::string>& history_hosts,
+               Publishers* publishers,
+               mojom::Feed* feed) {
+  std::list<mojom::ArticlePtr> articles;
+  std::list<mojom::PromotedArticlePtr> promoted_articles;
+  std::list<mojom::DealPtr> deals;
+  feed->hash = CollectFeedItems(feed_items, history_hosts, publishers,
+                                &articles, &promoted_articles, &deals);
+  BuildFeedPages(std::move(articles), std::move(promoted_articles),
+                 std::move(deals), 0, {}, {}, feed);
+  return true;
+}
+
+bool UpdateFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
+                const std::unordered_set<std::string>& history_hosts,
+                Publishers* publishers,
+                mojom::Feed* feed) {
+  std::list<mojom::ArticlePtr> articles;
+  std::list<mojom::PromotedArticlePtr> promoted_articles;
+  std::list<mojom::DealPtr> deals;
+  std::string hash = CollectFeedItems(feed_items, history_hosts, publishers,
+                                      &articles, &promoted_articles, &deals);
+  if (!feed->hash.empty() && hash == feed->hash) {
+    VLOG(1) << "Feed items did not change, keeping all pages";
+    return true;
+  }
+
+  std::unordered_set<std::string> urls;
+  for (const auto& article : articles) {
+    urls.insert(article->data->url.spec());
+  }
+  for (const auto& promoted_article : promoted_articles) {
+    urls.insert(promoted_article->data->url.spec());
+  }
+  for (const auto& deal : deals) {
+    urls.insert(deal->data->url.spec());
+  }
+
+  // A page has to be rebuilt if it shows an item that went away, or if an
+  // added article ranks ahead of one it shows. Every page after it has to be
+  // rebuilt too, since pages are filled in rank order.
+  std::unordered_set<std::string> previous_urls;
+  if (feed->featured_item) {
+    AddItemUrl(feed->featured_item, &previous_urls);
+  }
+  for (const auto& page : feed->pages) {
+    for (const auto& page_item : page->items) {
+      for (const auto& item : page_item->items) {
+        AddItemUrl(item, &previous_urls);
+      }
+    }
+  }
+  absl::optional<double> best_added_score;
+  for (const auto& article : articles) {
+    if (previous_urls.find(article->data->url.spec()) == previous_urls.end() &&
+        (!best_added_score || article->data->score < *best_added_score)) {
+      best_added_score = article->data->score;
+    }
+  }
+
+  // Everything depends on the featured item, as it is picked first.
+  if (feed->featured_item &&
+      urls.find(MetadataFromFeedItem(feed->featured_item)->url.spec()) ==
+          urls.end()) {
+    feed->featured_item = nullptr;
+    feed->pages.clear();
+  }
+  std::unordered_set<std::string> kept_urls;
+  if (feed->featured_item) {
+    AddItemUrl(feed->featured_item, &kept_urls);
+  }
+  // The categories the kept pages were given, which the rebuilt pages must
+  // not be given again.
+  std::unordered_set<std::string> used_category_names;
+  std::unordered_set<std::string> used_deal_category_names;
+  size_t kept_pages = 0;
+  absl::optional<double> worst_kept_score;
+  for (const auto& page : feed->pages) {
+    // The last page may have room for the added items.
+    if (&page == &feed->pages.back()) {
+      break;
+    }
+    std::unordered_set<std::string> page_urls;
+    std::unordered_set<std::string> page_category_names;
+    std::unordered_set<std::string> page_deal_category_names;
+    bool is_affected = false;
+    for (size_t i = 0; i < page->items.size(); i++) {
+      const auto& page_item = page->items[i];
+      // Only headlines which are not random are taken in rank order.
+      const bool is_ranked =
+          i < page_content_order.size() &&
+          (page_item->card_type == CardType::HEADLINE ||
+           page_item->card_type == CardType::HEADLINE_PAIRED);
+      // Category cards are filled from the page's category first.
+      if (!page_item->items.empty()) {
+        const auto& first_item = page_item->items.front();
+        if (page_item->card_type == CardType::CATEGORY_GROUP &&
+            first_item->is_article()) {
+          page_category_names.insert(
+              first_item->get_article()->data->category_name);
+        } else if (page_item->card_type == CardType::DEALS &&
+                   first_item->is_deal()) {
+          page_deal_category_names.insert(
+              first_item->get_deal()->offers_category);
+        }
+      }
+      for (const auto& item : page_item->items) {
+        const auto& metadata = MetadataFromFeedItem(item);
+        if (urls.find(metadata->url.spec()) == urls.end()) {
+          is_affected = true;
+        }
+        if (is_ranked &&
+            (!worst_kept_score || metadata->score > *worst_kept_score)) {
+          worst_kept_score = metadata->score;
+        }
+        page_urls.insert(metadata->url.spec());
+      }
+    }
+    if (best_added_score && worst_kept_score &&
+        *best_added_score <= *worst_kept_score) {
+      is_affected = true;
+    }
+    if (is_affected) {
+      break;
+    }
+    kept_urls.insert(page_urls.begin(), page_urls.end());
+    used_category_names.insert(page_category_names.begin(),
+                               page_category_names.end());
+    used_deal_category_names.insert(page_deal_category_names.begin(),
+                                    page_deal_category_names.end());
+    kept_pages++;
+  }
+  VLOG(1) << "Keeping " << kept_pages << " of " << feed->pages.size()
+          << " feed pages";
+
+  feed->pages.erase(feed->pages.begin() + kept_pages, feed->pages.end());
+  RemoveItemsWithUrls(kept_urls, &articles);
+  RemoveItemsWithUrls(kept_urls, &promoted_articles);
+  RemoveItemsWithUrls(kept_urls, &deals);
+  feed->hash = hash;
+  BuildFeedPages(std::move(articles), std::move(promoted_articles),
+                 std::move(deals), kept_pages, used_category_names,
+                 used_deal_category_names, feed);
   return true;
 }
 
@@ -22,6 +22,18 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
                Publishers* publishers,
                mojom::Feed* feed);
 
+// Brings |feed| up to date with |feed_items| without rebuilding the pages that
+// are not affected by the change. Pages are kept up to the first one that
+// shows an item which is no longer in |feed_items|, or that an added article
+// would have been ranked into; that page and the ones after it are built
+// again from the remaining items, as is the last page, which may have room for
+// added items. Does a full build if |feed| is empty or its featured item was
+// removed.
+bool UpdateFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
+                const std::unordered_set<std::string>& history_hosts,
+                Publishers* publishers,
+                mojom::Feed* feed);
+
 // Exposed for testing
 bool ShouldDisplayFeedItem(const mojom::FeedItemPtr& feed_item,
                            const Publishers* publishers);
@@ -6,11 +6,13 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "brave/components/brave_today/browser/feed_building.h"
 #include "brave/components/brave_today/browser/feed_parsing.h"
@@ -112,6 +114,59 @@ void PopulatePublishers(Publishers* publisher_list) {
                                    std::move(publisher3));
 }
 
+// Articles older than 2 days are never picked at random, so a feed made of
+// them is always built the same way.
+mojom::FeedItemPtr MakeArticle(int index,
+                               double score,
+                               const std::string& category = "Top News") {
+  return mojom::FeedItem::NewArticle(
+      mojom::Article::New(mojom::FeedItemMetadata::New(
+          category, base::Time::UnixEpoch() + base::Days(19000),
+          "Article " + base::NumberToString(index), "",
+          GURL("https://www.example.com/article-" +
+               base::NumberToString(index)),
+          "", mojom::Image::NewImageUrl(GURL("https://www.example.com/i.png")),
+          "111", "First Publisher", score, "7 days ago")));
+}
+
+std::vector<mojom::FeedItemPtr> MakeArticles(int count) {
+  std::vector<mojom::FeedItemPtr> feed_items;
+  for (int i = 0; i < count; i++) {
+    feed_items.push_back(MakeArticle(i, i + 1));
+  }
+  return feed_items;
+}
+
+// Sports and Business have the fewest articles, so after Top News they get
+// the category cards of the second and third pages. The Technology articles
+// rank first, so are all used up as headlines on the first page.
+std::vector<mojom::FeedItemPtr> MakeCategoryArticles() {
+  std::vector<mojom::FeedItemPtr> feed_items;
+  for (int i = 0; i < 71; i++) {
+    std::string category = "Top News";
+    if (i >= 1 && i <= 4) {
+      category = "Technology";
+    } else if (i == 66 || i == 67) {
+      category = "Sports";
+    } else if (i >= 68) {
+      category = "Business";
+    }
+    feed_items.push_back(MakeArticle(i, i + 1, category));
+  }
+  return feed_items;
+}
+
+bool PageContainsUrl(const mojom::FeedPagePtr& page, const GURL& url) {
+  for (const auto& page_item : page->items) {
+    for (const auto& item : page_item->items) {
+      if (item->is_article() && item->get_article()->data->url == url) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 }  // namespace
 
 TEST(BraveNewsFeedBuilding, BuildFeed) {
@@ -247,4 +302,105 @@ TEST(BraveNewsFeedBuilding, IncludesUserEnabledItems) {
   ASSERT_TRUE(ShouldDisplayFeedItem(feed_item, &publisher_list));
 }
 
+TEST(BraveNewsFeedBuilding, UpdateFeedKeepsUnchangedFeed) {
+  Publishers publisher_list;
+  PopulatePublishers(&publisher_list);
+  mojom::Feed feed;
+  ASSERT_TRUE(UpdateFeed(MakeArticles(60), {}, &publisher_list, &feed));
+  ASSERT_GE(feed.pages.size(), 2u);
+  auto previous = feed.Clone();
+
+  ASSERT_TRUE(UpdateFeed(MakeArticles(60), {}, &publisher_list, &feed));
+  EXPECT_TRUE(feed.Equals(*previous));
+}
+
+TEST(BraveNewsFeedBuilding, UpdateFeedKeepsPagesBeforeAddedArticle) {
+  Publishers publisher_list;
+  PopulatePublishers(&publisher_list);
+  mojom::Feed feed;
+  ASSERT_TRUE(UpdateFeed(MakeArticles(60), {}, &publisher_list, &feed));
+  ASSERT_GE(feed.pages.size(), 2u);
+  auto previous = feed.Clone();
+
+  // Ranks after everything else, so no existing page needs it.
+  auto feed_items = MakeArticles(60);
+  feed_items.push_back(MakeArticle(60, 1000));
+  ASSERT_TRUE(UpdateFeed(feed_items, {}, &publisher_list, &feed));
+  EXPECT_NE(feed.hash, previous->hash);
+  EXPECT_TRUE(feed.featured_item.Equals(previous->featured_item));
+  EXPECT_TRUE(feed.pages[0].Equals(previous->pages[0]));
+  bool found = false;
+  for (const auto& page : feed.pages) {
+    found |= PageContainsUrl(page, GURL("https://www.example.com/article-60"));
+  }
+  EXPECT_TRUE(found);
+
+  // Ranks ahead of everything but the featured item, so every page changes.
+  feed_items = MakeArticles(60);
+  feed_items.push_back(MakeArticle(61, 1.5));
+  ASSERT_TRUE(UpdateFeed(feed_items, {}, &publisher_list, &feed));
+  EXPECT_TRUE(feed.featured_item.Equals(previous->featured_item));
+  EXPECT_TRUE(PageContainsUrl(feed.pages[0],
+                              GURL("https://www.example.com/article-61")));
+}
+
+TEST(BraveNewsFeedBuilding, UpdateFeedRebuildsPagesOfRemovedArticle) {
+  Publishers publisher_list;
+  PopulatePublishers(&publisher_list);
+  mojom::Feed feed;
+  ASSERT_TRUE(UpdateFeed(MakeArticles(60), {}, &publisher_list, &feed));
+  ASSERT_GE(feed.pages.size(), 2u);
+  const GURL removed_url("https://www.example.com/article-5");
+  ASSERT_TRUE(PageContainsUrl(feed.pages[0], removed_url));
+
+  auto feed_items = MakeArticles(60);
+  feed_items.erase(feed_items.begin() + 5);
+  ASSERT_TRUE(UpdateFeed(feed_items, {}, &publisher_list, &feed));
+  for (const auto& page : feed.pages) {
+    EXPECT_FALSE(PageContainsUrl(page, removed_url));
+  }
+
+  // Removing the featured article starts over.
+  mojom::Feed expected;
+  feed_items = MakeArticles(60);
+  feed_items.erase(feed_items.begin());
+  ASSERT_TRUE(BuildFeed(feed_items, {}, &publisher_list, &expected));
+  feed_items = MakeArticles(60);
+  feed_items.erase(feed_items.begin());
+  ASSERT_TRUE(UpdateFeed(feed_items, {}, &publisher_list, &feed));
+  EXPECT_TRUE(feed.Equals(expected));
+}
+
+TEST(BraveNewsFeedBuilding, UpdateFeedKeepsCategoriesOfKeptPages) {
+  Publishers publisher_list;
+  PopulatePublishers(&publisher_list);
+  mojom::Feed feed;
+  ASSERT_TRUE(UpdateFeed(MakeCategoryArticles(), {}, &publisher_list, &feed));
+  ASSERT_EQ(feed.pages.size(), 3u);
+
+  // Ranks after everything else, so only the last page is built again, and
+  // it must get the category that is left rather than one a kept page has.
+  mojom::Feed expected;
+  auto feed_items = MakeCategoryArticles();
+  feed_items.push_back(MakeArticle(71, 1000));
+  ASSERT_TRUE(BuildFeed(feed_items, {}, &publisher_list, &expected));
+  feed_items = MakeCategoryArticles();
+  feed_items.push_back(MakeArticle(71, 1000));
+  ASSERT_TRUE(UpdateFeed(feed_items, {}, &publisher_list, &feed));
+  EXPECT_TRUE(feed.Equals(expected));
+
+  std::vector<std::string> category_names;
+  for (const auto& page : feed.pages) {
+    for (const auto& page_item : page->items) {
+      if (page_item->card_type == mojom::CardType::CATEGORY_GROUP) {
+        ASSERT_FALSE(page_item->items.empty());
+        category_names.push_back(
+            page_item->items[0]->get_article()->data->category_name);
+      }
+    }
+  }
+  EXPECT_EQ(category_names,
+            std::vector<std::string>({"Top News", "Sports", "Business"}));
+}
+
 }  // namespace brave_news
@@ -5,33 +5,45 @@
 
 #include "brave/components/brave_today/browser/feed_controller.h"
 
+#include <iterator>
 #include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
-#include "base/barrier_callback.h"
 #include "base/bind.h"
 #include "base/callback_forward.h"
 #include "base/one_shot_event.h"
+#include "base/time/time.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/direct_feed_controller.h"
 #include "brave/components/brave_today/browser/feed_building.h"
 #include "brave/components/brave_today/browser/feed_parsing.h"
+#include "brave/components/brave_today/browser/feed_snapshot.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/browser/urls.h"
 #include "brave/components/brave_today/common/brave_news.mojom-shared.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "components/history/core/browser/history_service.h"
 #include "components/history/core/browser/history_types.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_status_code.h"
 
 namespace brave_news {
 
 namespace {
 
 const char kEtagHeaderKey[] = "etag";
+// feed.json is a few megabytes; anything far larger is not a feed.
+constexpr size_t kMaxFeedBodySize = 32 * 1024 * 1024;
+// The items of a feed.json with more than this are not kept for reuse when it
+// has not changed, so it is downloaded again in full instead.
+constexpr size_t kMaxKeptCombinedFeedItems = 2000;
+// How long to wait for direct feeds after feed.json is in, before building a
+// feed without the ones that are not.
+constexpr base::TimeDelta kMaxDirectFeedsWait = base::Seconds(3);
 
 GURL GetFeedUrl() {
   GURL feed_url("https://" + brave_today::GetHostname() + "/brave-today/feed." +
@@ -45,13 +57,15 @@ FeedController::FeedController(
     PublishersController* publishers_controller,
     DirectFeedController* direct_feed_controller,
     history::HistoryService* history_service,
-    api_request_helper::APIRequestHelper* api_request_helper)
+    api_request_helper::APIRequestHelper* api_request_helper,
+    const base::FilePath& snapshot_path)
     : publishers_controller_(publishers_controller),
       direct_feed_controller_(direct_feed_controller),
       history_service_(history_service),
       api_request_helper_(api_request_helper),
       on_current_update_complete_(new base::OneShotEvent()),
-      publishers_observation_(this) {
+      publishers_observation_(this),
+      snapshot_store_(snapshot_path) {
   publishers_observation_.Observe(publishers_controller);
 }
 
@@ -111,72 +125,22 @@ void FeedController::EnsureFeedIsUpdating() {
             direct_feed_publishers.emplace_back(publisher.second->Clone());
           }
         }
-        // Handle all feed items downloaded
-        // Fetch https request via callback
-        auto feed_items_handler = base::BindOnce(
-            [](FeedController* controller, Publishers publishers,
-               std::vector<FeedItems> feed_items_unflat) {
-              // flatten the vectors
-              std::size_t total_size = 0;
-              for (const auto& collection : feed_items_unflat) {
-                total_size += collection.size();
-              }
-              VLOG(1) << "All feed item fetches done with item count: "
-                      << total_size;
-              if (total_size == 0) {
-                controller->NotifyUpdateDone();
-                return;
-              }
-              FeedItems all_feed_items;
-              all_feed_items.reserve(total_size);
-              for (auto& collection : feed_items_unflat) {
-                auto it = collection.begin();
-                while (it != collection.end()) {
-                  all_feed_items.insert(all_feed_items.end(),
-                                        *std::make_move_iterator(it));
-                  it = collection.erase(it);
-                }
-              }
-
-              // Get history hosts via callback
-              auto onHistory = base::BindOnce(
-                  [](FeedController* controller, FeedItems all_feed_items,
-                     Publishers publishers, history::QueryResults results) {
-                    std::unordered_set<std::string> history_hosts;
-                    for (const auto& item : results) {
-                      auto host = item.url().host();
-                      history_hosts.insert(host);
-                    }
-                    VLOG(1) << "history hosts # " << history_hosts.size();
-                    // Parse directly to in-memory property
-                    controller->ResetFeed();
-                    std::vector<mojom::FeedItemPtr> feed_items;
-                    if (BuildFeed(all_feed_items, history_hosts, &publishers,
-                                  &controller->current_feed_)) {
-                    } else {
-                      VLOG(1) << "ParseFeed reported failure.";
-                    }
-                    // Let any callbacks know that the data is ready or errored.
-                    controller->NotifyUpdateDone();
-                  },
-                  base::Unretained(controller), std::move(all_feed_items),
-                  std::move(publishers));
-              history::QueryOptions options;
-              options.max_count = 2000;
-              options.SetRecentDayRange(14);
-              controller->history_service_->QueryHistory(
-                  std::u16string(), options, std::move(onHistory),
-                  &controller->task_tracker_);
-            },
-            base::Unretained(controller), std::move(publishers));
+        controller->update_publishers_ = std::move(publishers);
+        controller->update_feed_items_.clear();
+        controller->is_combined_feed_fetched_ = false;
+        controller->are_direct_feeds_fetched_ = false;
         // Perform all feed downloads in parallel
-        auto fetch_items_handler =
-            base::BarrierCallback<FeedItems>(2, std::move(feed_items_handler));
-        controller->FetchCombinedFeed(fetch_items_handler);
+        controller->FetchCombinedFeed(
+            base::BindOnce(&FeedController::OnCombinedFeedFetched,
+                           base::Unretained(controller)));
         VLOG(1) << "Feed Controller found " << direct_feed_publishers.size()
                 << " direct feeds.";
         controller->direct_feed_controller_->DownloadAllContent(
-            std::move(direct_feed_publishers), fetch_items_handler);
+            std::move(direct_feed_publishers),
+            base::BindRepeating(&FeedController::OnDirectFeedItemsReceived,
+                                base::Unretained(controller)),
+            base::BindOnce(&FeedController::OnDirectFeedsFetched,
+                           base::Unretained(controller)));
       },
       base::Unretained(this)));
 }
@@ -233,6 +197,12 @@ void FeedController::UpdateIfRemoteChanged() {
 
 void FeedController::ClearCache() {
   ResetFeed();
+  combined_feed_items_.clear();
+  current_feed_etag_.clear();
+  // Also drops a snapshot that is still being loaded.
+  can_use_snapshot_ = false;
+  snapshot_hash_.clear();
+  snapshot_store_.Delete();
 }
 
 void FeedController::OnPublishersUpdated(PublishersController* controller) {
@@ -244,15 +214,26 @@ void FeedController::FetchCombinedFeed(GetFeedItemsCallback callback) {
   // Handle the response
   auto response_handler = base::BindOnce(
       [](FeedController* controller, GetFeedItemsCallback callback, int status,
-         const std::string& body,
+         absl::optional<FeedItems> feed_items,
          const base::flat_map<std::string, std::string>& headers) {
         std::string etag;
         if (headers.contains(kEtagHeaderKey)) {
           etag = headers.at(kEtagHeaderKey);
         }
         VLOG(1) << "Downloaded feed, status: " << status << " etag: " << etag;
+        // Feed has not changed since the last fetch, so reuse its items.
+        if (status == net::HTTP_NOT_MODIFIED &&
+            !controller->combined_feed_items_.empty()) {
+          FeedItems feed_items;
+          feed_items.reserve(controller->combined_feed_items_.size());
+          for (const auto& item : controller->combined_feed_items_) {
+            feed_items.push_back(item->Clone());
+          }
+          std::move(callback).Run(std::move(feed_items));
+          return;
+        }
         // Handle bad response
-        if (status != 200 || body.empty()) {
+        if (status != 200 || !feed_items) {
           LOG(ERROR) << "Bad response from brave news feed.json. Status: "
                      << status;
           std::move(callback).Run({});
@@ -261,17 +242,33 @@ void FeedController::FetchCombinedFeed(GetFeedItemsCallback callback) {
         // Only mark cache time of remote request if
         // parsing was successful
         controller->current_feed_etag_ = etag;
-        FeedItems feed_items;
-        ParseFeedItems(body, &feed_items);
-        std::move(callback).Run(std::move(feed_items));
+        controller->combined_feed_items_.clear();
+        if (feed_items->size() <= kMaxKeptCombinedFeedItems) {
+          controller->combined_feed_items_.reserve(feed_items->size());
+          for (const auto& item : *feed_items) {
+            controller->combined_feed_items_.push_back(item->Clone());
+          }
+        }
+        std::move(callback).Run(std::move(*feed_items));
       },
       base::Unretained(this), std::move(callback));
   // Send the request
   GURL feed_url(GetFeedUrl());
   VLOG(1) << "Making feed request to " << feed_url.spec();
-  api_request_helper_->Request("GET", feed_url, "", "", true,
-                               std::move(response_handler),
-                               brave::private_cdn_headers);
+  auto headers = brave::private_cdn_headers;
+  if (!combined_feed_items_.empty() && !current_feed_etag_.empty()) {
+    headers[net::HttpRequestHeaders::kIfNoneMatch] = current_feed_etag_;
+  }
+  // Both the JSON and the feed items are parsed off the UI thread.
+  api_request_helper_->RequestJSONAs<FeedItems>(
+      "GET", feed_url, "", "", true,
+      base::BindOnce([](base::Value records_v) -> absl::optional<FeedItems> {
+        FeedItems feed_items;
+        ParseFeedItems(records_v, &feed_items);
+        return feed_items;
+      }),
+      std::move(response_handler), headers, kMaxFeedBodySize,
+      api_request_helper::JSONDecodeCaller::kBraveNewsFeed);
 }
 
 void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
@@ -284,25 +281,150 @@ void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
     std::move(callback).Run();
     return;
   }
+  // Before the first update of the session, show the feed of the last one
+  // if there is a recent enough snapshot of it.
+  if (can_use_snapshot_) {
+    snapshot_callbacks_.push_back(std::move(callback));
+    if (snapshot_callbacks_.size() == 1) {
+      snapshot_store_.Load(base::BindOnce(&FeedController::OnSnapshotLoaded,
+                                          weak_ptr_factory_.GetWeakPtr()));
+    }
+    return;
+  }
   // Ensure feed is currently being fetched.
   // Subscribe to result of current feed fetch.
   on_current_update_complete_->Post(FROM_HERE, std::move(callback));
   EnsureFeedIsUpdating();
 }
 
+void FeedController::OnSnapshotLoaded(std::unique_ptr<FeedSnapshot> snapshot) {
+  // The cache may have been cleared, or an update done, while loading.
+  if (snapshot && can_use_snapshot_ && current_feed_.hash.empty()) {
+    VLOG(1) << "Showing Brave News feed snapshot: " << snapshot->feed->hash;
+    current_feed_.hash = std::move(snapshot->feed->hash);
+    current_feed_.pages = std::move(snapshot->feed->pages);
+    current_feed_.featured_item = std::move(snapshot->feed->featured_item);
+    snapshot_hash_ = current_feed_.hash;
+    publishers_controller_->SeedPublishers(std::move(snapshot->publishers));
+    // Refresh the publishers, which then refreshes the feed on top of the
+    // snapshot.
+    publishers_controller_->EnsurePublishersIsUpdating();
+  }
+  can_use_snapshot_ = false;
+  std::vector<base::OnceClosure> callbacks = std::move(snapshot_callbacks_);
+  snapshot_callbacks_.clear();
+  for (auto& callback : callbacks) {
+    GetOrFetchFeed(std::move(callback));
+  }
+}
+
+void FeedController::OnCombinedFeedFetched(FeedItems feed_items) {
+  std::move(feed_items.begin(), feed_items.end(),
+            std::back_inserter(update_feed_items_));
+  is_combined_feed_fetched_ = true;
+  if (are_direct_feeds_fetched_) {
+    BuildUpdatedFeed(true);
+    return;
+  }
+  // Show what we have if the direct feeds take too long, and add the rest of
+  // them once they are in.
+  direct_feeds_timer_.Start(
+      FROM_HERE, kMaxDirectFeedsWait,
+      base::BindOnce(&FeedController::BuildUpdatedFeed, base::Unretained(this),
+                     false));
+}
+
+void FeedController::OnDirectFeedItemsReceived(FeedItems feed_items) {
+  std::move(feed_items.begin(), feed_items.end(),
+            std::back_inserter(update_feed_items_));
+}
+
+void FeedController::OnDirectFeedsFetched() {
+  are_direct_feeds_fetched_ = true;
+  if (is_combined_feed_fetched_) {
+    direct_feeds_timer_.Stop();
+    BuildUpdatedFeed(true);
+  }
+}
+
+void FeedController::BuildUpdatedFeed(bool is_complete) {
+  VLOG(1) << "Feed item fetches " << (is_complete ? "done" : "partially done")
+          << " with item count: " << update_feed_items_.size();
+  if (update_feed_items_.empty()) {
+    if (is_complete) {
+      NotifyUpdateDone();
+    }
+    return;
+  }
+  // Get history hosts via callback
+  history::QueryOptions options;
+  options.max_count = 2000;
+  options.SetRecentDayRange(14);
+  history_service_->QueryHistory(
+      std::u16string(), options,
+      base::BindOnce(&FeedController::OnHistoryQueried, base::Unretained(this),
+                     is_complete),
+      &task_tracker_);
+}
+
+void FeedController::OnHistoryQueried(bool is_complete,
+                                      history::QueryResults results) {
+  std::unordered_set<std::string> history_hosts;
+  for (const auto& item : results) {
+    auto host = item.url().host();
+    history_hosts.insert(host);
+  }
+  VLOG(1) << "history hosts # " << history_hosts.size();
+  // Building takes the items apart, so keep a copy while more may come.
+  FeedItems feed_items;
+  if (is_complete) {
+    feed_items = std::move(update_feed_items_);
+    update_feed_items_.clear();
+  } else {
+    feed_items.reserve(update_feed_items_.size());
+    for (const auto& item : update_feed_items_) {
+      feed_items.push_back(item->Clone());
+    }
+  }
+  // Parse directly to in-memory property, only rebuilding the pages affected
+  // by what changed since last time.
+  if (!UpdateFeed(feed_items, history_hosts, &update_publishers_,
+                  &current_feed_)) {
+    VLOG(1) << "ParseFeed reported failure.";
+  }
+  if (!is_complete) {
+    // Let anyone waiting have the partial feed. The rest is added when the
+    // remaining direct feeds are in, which changes the feed hash so the UI
+    // can offer to show it.
+    NotifyFeedReady();
+    return;
+  }
+  if (!current_feed_.hash.empty() && current_feed_.hash != snapshot_hash_) {
+    snapshot_store_.Save(current_feed_, update_publishers_);
+    snapshot_hash_ = current_feed_.hash;
+  }
+  update_publishers_.clear();
+  // Let any callbacks know that the data is ready or errored.
+  NotifyUpdateDone();
+}
+
 void FeedController::ResetFeed() {
   current_feed_.featured_item = nullptr;
   current_feed_.hash = "";
   current_feed_.pages.clear();
 }
 
-void FeedController::NotifyUpdateDone() {
+void FeedController::NotifyFeedReady() {
   // Let any callbacks know that the data is ready.
   on_current_update_complete_->Signal();
   // Reset the OneShotEvent so that future requests
   // can be waited for.
-  is_update_in_progress_ = false;
   on_current_update_complete_ = std::make_unique<base::OneShotEvent>();
 }
 
+void FeedController::NotifyUpdateDone() {
+  is_update_in_progress_ = false;
+  NotifyFeedReady();
+}
+
 }  // namespace brave_news
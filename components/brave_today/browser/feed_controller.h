@@ -10,14 +10,19 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
 #include "base/scoped_observation.h"
+#include "base/timer/timer.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_today/browser/direct_feed_controller.h"
+#include "brave/components/brave_today/browser/feed_snapshot.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "components/history/core/browser/history_service.h"
+#include "components/history/core/browser/history_types.h"
 
 namespace history {
 class HistoryService;
@@ -34,7 +39,8 @@ class FeedController : public PublishersController::Observer {
   FeedController(PublishersController* publishers_controller,
                  DirectFeedController* direct_feed_controller,
                  history::HistoryService* history_service,
-                 api_request_helper::APIRequestHelper* api_request_helper);
+                 api_request_helper::APIRequestHelper* api_request_helper,
+                 const base::FilePath& snapshot_path);
   ~FeedController() override;
   FeedController(const FeedController&) = delete;
   FeedController& operator=(const FeedController&) = delete;
@@ -65,8 +71,18 @@ class FeedController : public PublishersController::Observer {
 
  private:
   void FetchCombinedFeed(GetFeedItemsCallback callback);
+  void OnCombinedFeedFetched(FeedItems feed_items);
+  void OnDirectFeedItemsReceived(FeedItems feed_items);
+  void OnDirectFeedsFetched();
+  // Builds the feed from the items fetched so far. |is_complete| is false if
+  // some direct feeds are still being downloaded.
+  void BuildUpdatedFeed(bool is_complete);
+  void OnHistoryQueried(bool is_complete, history::QueryResults results);
   void GetOrFetchFeed(base::OnceClosure callback);
+  void OnSnapshotLoaded(std::unique_ptr<FeedSnapshot> snapshot);
   void ResetFeed();
+  // Runs the callbacks waiting for the feed, without ending the update.
+  void NotifyFeedReady();
   void NotifyUpdateDone();
 
   raw_ptr<PublishersController> publishers_controller_ = nullptr;
@@ -85,7 +101,28 @@ class FeedController : public PublishersController::Observer {
   // every time the UI opens.
   mojom::Feed current_feed_;
   std::string current_feed_etag_;
+  // Items of the last feed.json that was downloaded, so they can be reused
+  // when the server says it has not changed. Every item is kept, as any of
+  // them may be shown once the user enables its publisher, but only for a
+  // feed.json of up to kMaxKeptCombinedFeedItems items.
+  FeedItems combined_feed_items_;
   bool is_update_in_progress_ = false;
+  // State of the update in progress, gathered as fetches complete.
+  Publishers update_publishers_;
+  FeedItems update_feed_items_;
+  bool is_combined_feed_fetched_ = false;
+  bool are_direct_feeds_fetched_ = false;
+  base::OneShotTimer direct_feeds_timer_;
+  // The feed of the last session, shown until the first update is done.
+  FeedSnapshotStore snapshot_store_;
+  // Whether the snapshot may still be shown, which it may not once it has
+  // been loaded or the cache has been cleared.
+  bool can_use_snapshot_ = true;
+  // Callbacks waiting for the snapshot to be loaded.
+  std::vector<base::OnceClosure> snapshot_callbacks_;
+  // Hash of the feed that was last stored in the snapshot.
+  std::string snapshot_hash_;
+  base::WeakPtrFactory<FeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
@@ -126,10 +126,15 @@ bool ParseFeedItems(const std::string& json,
     LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
     return false;
   }
-  if (!records_v->is_list()) {
+  return ParseFeedItems(*records_v, feed_items);
+}
+
+bool ParseFeedItems(const base::Value& records_v,
+                    std::vector<mojom::FeedItemPtr>* feed_items) {
+  if (!records_v.is_list()) {
     return false;
   }
-  for (const base::Value& feed_item_raw : records_v->GetList()) {
+  for (const base::Value& feed_item_raw : records_v.GetList()) {
     auto item = mojom::FeedItem::New();
     std::string item_hash;
     if (ParseFeedItem(feed_item_raw, &item)) {
@@ -16,6 +16,8 @@ namespace brave_news {
 
 bool ParseFeedItems(const std::string& json,
                     std::vector<mojom::FeedItemPtr>* feed_items);
+bool ParseFeedItems(const base::Value& records_v,
+                    std::vector<mojom::FeedItemPtr>* feed_items);
 
 }  // namespace brave_news
 
@@ -0,0 +1,171 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/feed_snapshot.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/pickle.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "brave/components/version_info/version_info.h"
+
+namespace brave_news {
+
+namespace {
+
+// Bump when the layout of the pickle changes. The mojo structs it holds are
+// not [Stable], so snapshots are also tied to the browser version that wrote
+// them.
+constexpr int kSnapshotVersion = 2;
+// A built feed is a few hundred kilobytes.
+constexpr int64_t kMaxSnapshotFileSize = 16 * 1024 * 1024;
+
+void WriteBytes(const std::vector<uint8_t>& bytes, base::Pickle* pickle) {
+  pickle->WriteData(reinterpret_cast<const char*>(bytes.data()),
+                    base::checked_cast<int>(bytes.size()));
+}
+
+std::unique_ptr<FeedSnapshot> ReadSnapshot(const base::FilePath& path) {
+  std::string data;
+  if (!base::ReadFileToStringWithMaxSize(path, &data, kMaxSnapshotFileSize)) {
+    return nullptr;
+  }
+  auto snapshot =
+      DeserializeFeedSnapshot(data, GetFeedSnapshotBrowserVersion());
+  if (!snapshot) {
+    VLOG(1) << "Brave News feed snapshot could not be read";
+    return nullptr;
+  }
+  const base::TimeDelta age = base::Time::Now() - snapshot->created;
+  if (age.is_negative() || age > FeedSnapshotStore::kMaxSnapshotAge) {
+    VLOG(1) << "Brave News feed snapshot is too old";
+    return nullptr;
+  }
+  return snapshot;
+}
+
+void WriteSnapshot(const base::FilePath& path,
+                   std::unique_ptr<FeedSnapshot> snapshot) {
+  const std::string data =
+      SerializeFeedSnapshot(*snapshot, GetFeedSnapshotBrowserVersion());
+  if (!base::CreateDirectory(path.DirName())) {
+    VLOG(1) << "Could not create Brave News directory";
+    return;
+  }
+  base::ImportantFileWriter::WriteFileAtomically(path, data);
+}
+
+}  // namespace
+
+FeedSnapshot::FeedSnapshot() = default;
+FeedSnapshot::FeedSnapshot(FeedSnapshot&&) = default;
+FeedSnapshot& FeedSnapshot::operator=(FeedSnapshot&&) = default;
+FeedSnapshot::~FeedSnapshot() = default;
+
+std::string GetFeedSnapshotBrowserVersion() {
+  return version_info::GetBraveVersionWithoutChromiumMajorVersion() + "/" +
+         version_info::GetBraveChromiumVersionNumber();
+}
+
+std::string SerializeFeedSnapshot(const FeedSnapshot& snapshot,
+                                  const std::string& browser_version) {
+  DCHECK(snapshot.feed);
+  base::Pickle pickle;
+  pickle.WriteInt(kSnapshotVersion);
+  pickle.WriteString(browser_version);
+  pickle.WriteInt64(
+      snapshot.created.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  auto feed = snapshot.feed.Clone();
+  WriteBytes(mojom::Feed::Serialize(&feed), &pickle);
+  pickle.WriteUInt32(base::checked_cast<uint32_t>(snapshot.publishers.size()));
+  for (const auto& kv : snapshot.publishers) {
+    auto publisher = kv.second.Clone();
+    WriteBytes(mojom::Publisher::Serialize(&publisher), &pickle);
+  }
+  return std::string(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+std::unique_ptr<FeedSnapshot> DeserializeFeedSnapshot(
+    const std::string& data,
+    const std::string& browser_version) {
+  base::Pickle pickle(data.data(), data.size());
+  base::PickleIterator iter(pickle);
+  int version;
+  std::string snapshot_browser_version;
+  int64_t created;
+  const char* bytes;
+  int length;
+  if (!iter.ReadInt(&version) || version != kSnapshotVersion ||
+      !iter.ReadString(&snapshot_browser_version) ||
+      snapshot_browser_version != browser_version ||
+      !iter.ReadInt64(&created) || !iter.ReadData(&bytes, &length)) {
+    return nullptr;
+  }
+  auto snapshot = std::make_unique<FeedSnapshot>();
+  snapshot->created =
+      base::Time::FromDeltaSinceWindowsEpoch(base::Microseconds(created));
+  if (!mojom::Feed::Deserialize(bytes, length, &snapshot->feed)) {
+    return nullptr;
+  }
+  uint32_t publisher_count;
+  if (!iter.ReadUInt32(&publisher_count)) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < publisher_count; i++) {
+    mojom::PublisherPtr publisher;
+    if (!iter.ReadData(&bytes, &length) ||
+        !mojom::Publisher::Deserialize(bytes, length, &publisher)) {
+      return nullptr;
+    }
+    const std::string publisher_id = publisher->publisher_id;
+    snapshot->publishers.insert_or_assign(publisher_id, std::move(publisher));
+  }
+  return snapshot;
+}
+
+FeedSnapshotStore::FeedSnapshotStore(const base::FilePath& path)
+    : path_(path),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+FeedSnapshotStore::~FeedSnapshotStore() = default;
+
+void FeedSnapshotStore::Load(LoadCallback callback) {
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&ReadSnapshot, path_), std::move(callback));
+}
+
+void FeedSnapshotStore::Save(const mojom::Feed& feed,
+                             const Publishers& publishers) {
+  // Only the copy is made here, serializing it is left to the file sequence.
+  auto snapshot = std::make_unique<FeedSnapshot>();
+  snapshot->created = base::Time::Now();
+  snapshot->feed = feed.Clone();
+  for (const auto& kv : publishers) {
+    snapshot->publishers.insert_or_assign(kv.first, kv.second->Clone());
+  }
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&WriteSnapshot, path_, std::move(snapshot)));
+}
+
+void FeedSnapshotStore::Delete() {
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(base::GetDeleteFileCallback(), path_));
+}
+
+}  // namespace brave_news
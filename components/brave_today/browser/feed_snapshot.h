@@ -0,0 +1,80 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_FEED_SNAPSHOT_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_FEED_SNAPSHOT_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback_forward.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "brave/components/brave_today/browser/publishers_parsing.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace brave_news {
+
+// A built feed along with the publishers it was built from.
+struct FeedSnapshot {
+  FeedSnapshot();
+  FeedSnapshot(FeedSnapshot&&);
+  FeedSnapshot& operator=(FeedSnapshot&&);
+  ~FeedSnapshot();
+
+  base::Time created;
+  mojom::FeedPtr feed;
+  Publishers publishers;
+};
+
+// The version of the browser, which FeedSnapshotStore writes snapshots with
+// and only reads them back with.
+std::string GetFeedSnapshotBrowserVersion();
+
+// Serializes |snapshot| as a base::Pickle of its mojo-serialized structs,
+// headed by |browser_version|. Deserializing fails unless it is given the
+// same |browser_version|, as the mojo wire format is not stable across
+// versions. Exposed for testing.
+std::string SerializeFeedSnapshot(const FeedSnapshot& snapshot,
+                                  const std::string& browser_version);
+std::unique_ptr<FeedSnapshot> DeserializeFeedSnapshot(
+    const std::string& data,
+    const std::string& browser_version);
+
+// Keeps the last built feed in a file, so that the next session can show it
+// right away instead of waiting for a new one to be fetched and built.
+class FeedSnapshotStore {
+ public:
+  // Snapshots older than this are not shown, as their content is stale.
+  static constexpr base::TimeDelta kMaxSnapshotAge = base::Days(1);
+
+  // |snapshot| is nullptr if there is no usable snapshot.
+  using LoadCallback =
+      base::OnceCallback<void(std::unique_ptr<FeedSnapshot> snapshot)>;
+
+  explicit FeedSnapshotStore(const base::FilePath& path);
+  ~FeedSnapshotStore();
+  FeedSnapshotStore(const FeedSnapshotStore&) = delete;
+  FeedSnapshotStore& operator=(const FeedSnapshotStore&) = delete;
+
+  // Reads and deserializes the snapshot off this sequence.
+  void Load(LoadCallback callback);
+  // Replaces the stored snapshot with a copy of |feed| and |publishers|.
+  void Save(const mojom::Feed& feed, const Publishers& publishers);
+  void Delete();
+
+ private:
+  base::FilePath path_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_FEED_SNAPSHOT_H_
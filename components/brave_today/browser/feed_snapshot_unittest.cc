@@ -0,0 +1,143 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/feed_snapshot.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+namespace {
+
+mojom::FeedItemPtr MakeArticle(const std::string& url) {
+  auto metadata = mojom::FeedItemMetadata::New();
+  metadata->title = "An article";
+  metadata->url = GURL(url);
+  metadata->publisher_id = "publisher";
+  metadata->publish_time = base::Time::UnixEpoch() + base::Days(19000);
+  metadata->image = mojom::Image::NewImageUrl(GURL(url + ".jpg"));
+  metadata->score = 12.5;
+  return mojom::FeedItem::NewArticle(mojom::Article::New(std::move(metadata)));
+}
+
+FeedSnapshot MakeSnapshot(base::Time created) {
+  FeedSnapshot snapshot;
+  snapshot.created = created;
+  snapshot.feed = mojom::Feed::New();
+  snapshot.feed->hash = "hash";
+  snapshot.feed->featured_item = MakeArticle("https://www.example.com/1");
+  auto page_item = mojom::FeedPageItem::New();
+  page_item->card_type = mojom::CardType::HEADLINE;
+  page_item->items.push_back(MakeArticle("https://www.example.com/2"));
+  auto page = mojom::FeedPage::New();
+  page->items.push_back(std::move(page_item));
+  snapshot.feed->pages.push_back(std::move(page));
+  auto publisher = mojom::Publisher::New();
+  publisher->publisher_id = "publisher";
+  publisher->publisher_name = "A Publisher";
+  publisher->type = mojom::PublisherType::COMBINED_SOURCE;
+  publisher->is_enabled = true;
+  snapshot.publishers.insert_or_assign("publisher", std::move(publisher));
+  return snapshot;
+}
+
+}  // namespace
+
+TEST(BraveNewsFeedSnapshot, SerializesAndDeserializes) {
+  const base::Time created = base::Time::UnixEpoch() + base::Days(19000);
+  FeedSnapshot snapshot = MakeSnapshot(created);
+
+  auto result = DeserializeFeedSnapshot(SerializeFeedSnapshot(snapshot, "1.0"),
+                                        "1.0");
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->created, created);
+  EXPECT_TRUE(result->feed.Equals(snapshot.feed));
+  ASSERT_EQ(result->publishers.size(), 1u);
+  EXPECT_TRUE(
+      result->publishers["publisher"].Equals(snapshot.publishers["publisher"]));
+}
+
+TEST(BraveNewsFeedSnapshot, RejectsInvalidData) {
+  std::string data =
+      SerializeFeedSnapshot(MakeSnapshot(base::Time::Now()), "1.0");
+  EXPECT_FALSE(DeserializeFeedSnapshot("", "1.0"));
+  EXPECT_FALSE(DeserializeFeedSnapshot("not a snapshot", "1.0"));
+  EXPECT_FALSE(
+      DeserializeFeedSnapshot(data.substr(0, data.size() / 2), "1.0"));
+}
+
+TEST(BraveNewsFeedSnapshot, RejectsOtherBrowserVersions) {
+  std::string data =
+      SerializeFeedSnapshot(MakeSnapshot(base::Time::Now()), "1.0");
+  EXPECT_TRUE(DeserializeFeedSnapshot(data, "1.0"));
+  EXPECT_FALSE(DeserializeFeedSnapshot(data, "1.1"));
+}
+
+class FeedSnapshotStoreTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath GetSnapshotPath() {
+    return temp_dir_.GetPath().AppendASCII("Brave News").AppendASCII("Feed");
+  }
+
+  std::unique_ptr<FeedSnapshot> Load(FeedSnapshotStore* store) {
+    std::unique_ptr<FeedSnapshot> result;
+    base::RunLoop run_loop;
+    store->Load(base::BindLambdaForTesting(
+        [&](std::unique_ptr<FeedSnapshot> snapshot) {
+          result = std::move(snapshot);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(FeedSnapshotStoreTest, SavesLoadsAndDeletes) {
+  FeedSnapshotStore store(GetSnapshotPath());
+  EXPECT_FALSE(Load(&store));
+
+  FeedSnapshot snapshot = MakeSnapshot(base::Time::Now());
+  store.Save(*snapshot.feed, snapshot.publishers);
+  auto result = Load(&store);
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->feed.Equals(snapshot.feed));
+  EXPECT_EQ(result->publishers.size(), 1u);
+
+  store.Delete();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(GetSnapshotPath()));
+  EXPECT_FALSE(Load(&store));
+}
+
+TEST_F(FeedSnapshotStoreTest, IgnoresOldSnapshots) {
+  ASSERT_TRUE(base::CreateDirectory(GetSnapshotPath().DirName()));
+  const std::string data = SerializeFeedSnapshot(
+      MakeSnapshot(base::Time::Now() - FeedSnapshotStore::kMaxSnapshotAge -
+                   base::Hours(1)),
+      GetFeedSnapshotBrowserVersion());
+  ASSERT_TRUE(base::WriteFile(GetSnapshotPath(), data));
+
+  FeedSnapshotStore store(GetSnapshotPath());
+  EXPECT_FALSE(Load(&store));
+}
+
+}  // namespace brave_news
@@ -23,6 +23,13 @@
 
 namespace brave_news {
 
+namespace {
+
+// sources.json is a few hundred kilobytes.
+constexpr size_t kMaxSourcesBodySize = 8 * 1024 * 1024;
+
+}  // namespace
+
 PublishersController::PublishersController(
     PrefService* prefs,
     api_request_helper::APIRequestHelper* api_request_helper)
@@ -91,12 +98,14 @@ void PublishersController::EnsurePublishersIsUpdating() {
                    brave_today::GetRegionUrlPart() + "json");
   auto onRequest = base::BindOnce(
       [](PublishersController* controller, const int status,
-         const std::string& body,
+         absl::optional<Publishers> combined_publishers,
          const base::flat_map<std::string, std::string>& headers) {
         VLOG(1) << "Downloaded sources, status: " << status;
         // TODO(petemill): handle bad status or response
         Publishers publisher_list;
-        ParseCombinedPublisherList(body, &publisher_list);
+        if (combined_publishers) {
+          publisher_list = std::move(*combined_publishers);
+        }
         // Add user enabled statuses
         const base::Value* publisher_prefs =
             controller->prefs_->GetDictionary(prefs::kBraveTodaySources);
@@ -143,9 +152,24 @@ void PublishersController::EnsurePublishersIsUpdating() {
         }
       },
       base::Unretained(this));
-  api_request_helper_->Request("GET", sources_url, "", "", true,
-                               std::move(onRequest),
-                               brave::private_cdn_headers);
+  api_request_helper_->RequestJSONAs<Publishers>(
+      "GET", sources_url, "", "", true,
+      base::BindOnce([](base::Value records_v) -> absl::optional<Publishers> {
+        Publishers publishers;
+        if (!ParseCombinedPublisherList(records_v, &publishers)) {
+          return absl::nullopt;
+        }
+        return publishers;
+      }),
+      std::move(onRequest), brave::private_cdn_headers, kMaxSourcesBodySize,
+      api_request_helper::JSONDecodeCaller::kBraveNewsPublishers);
+}
+
+void PublishersController::SeedPublishers(Publishers publishers) {
+  if (!publishers_.empty() || is_update_in_progress_) {
+    return;
+  }
+  publishers_ = std::move(publishers);
 }
 
 void PublishersController::ClearCache() {
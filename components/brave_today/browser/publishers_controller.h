@@ -41,6 +41,9 @@ class PublishersController {
   void GetOrFetchPublishers(GetPublishersCallback callback,
                             bool wait_for_current_update = false);
   void EnsurePublishersIsUpdating();
+  // Uses |publishers|, e.g. from the last session, until the next update.
+  // Does nothing if publishers were already fetched.
+  void SeedPublishers(Publishers publishers);
   void ClearCache();
 
  private:
@@ -29,10 +29,16 @@ bool ParseCombinedPublisherList(const std::string& json,
     LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
     return false;
   }
-  if (!records_v->is_list()) {
+  return ParseCombinedPublisherList(*records_v, publishers);
+}
+
+bool ParseCombinedPublisherList(const base::Value& records_v,
+                                Publishers* publishers) {
+  DCHECK(publishers);
+  if (!records_v.is_list()) {
     return false;
   }
-  for (const base::Value& publisher_raw : records_v->GetList()) {
+  for (const base::Value& publisher_raw : records_v.GetList()) {
     auto publisher = brave_news::mojom::Publisher::New();
     publisher->publisher_id = *publisher_raw.FindStringKey("publisher_id");
     publisher->type = mojom::PublisherType::COMBINED_SOURCE;
@@ -17,6 +17,8 @@ namespace brave_news {
 
 bool ParseCombinedPublisherList(const std::string& json,
                                 Publishers* publishers);
+bool ParseCombinedPublisherList(const base::Value& records_v,
+                                Publishers* publishers);
 
 void ParseDirectPublisherList(const base::Value* direct_feeds_pref_value,
                               std::vector<mojom::PublisherPtr>* publishers);
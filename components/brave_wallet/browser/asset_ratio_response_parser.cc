@@ -53,9 +53,17 @@ bool ParseAssetPrice(const std::string& json,
     LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
     return false;
   }
+  return ParseAssetPrice(*records_v, from_assets, to_assets, values);
+}
+
+bool ParseAssetPrice(const base::Value& records_v,
+                     const std::vector<std::string>& from_assets,
+                     const std::vector<std::string>& to_assets,
+                     std::vector<mojom::AssetPricePtr>* values) {
+  DCHECK(values);
 
   const base::DictionaryValue* response_dict;
-  if (!records_v->GetAsDictionary(&response_dict)) {
+  if (!records_v.GetAsDictionary(&response_dict)) {
     return false;
   }
 
@@ -127,9 +135,15 @@ bool ParseAssetPriceHistory(const std::string& json,
     LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
     return false;
   }
+  return ParseAssetPriceHistory(*records_v, values);
+}
+
+bool ParseAssetPriceHistory(const base::Value& records_v,
+                            std::vector<mojom::AssetTimePricePtr>* values) {
+  DCHECK(values);
 
   const base::DictionaryValue* response_dict;
-  if (!records_v->GetAsDictionary(&response_dict)) {
+  if (!records_v.GetAsDictionary(&response_dict)) {
     return false;
   }
 
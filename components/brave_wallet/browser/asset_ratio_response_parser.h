@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/time/time.h"
+#include "base/values.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 
 namespace brave_wallet {
@@ -19,8 +20,14 @@ bool ParseAssetPrice(const std::string& json,
                      const std::vector<std::string>& from_assets,
                      const std::vector<std::string>& to_assets,
                      std::vector<mojom::AssetPricePtr>* values);
+bool ParseAssetPrice(const base::Value& records_v,
+                     const std::vector<std::string>& from_assets,
+                     const std::vector<std::string>& to_assets,
+                     std::vector<mojom::AssetPricePtr>* values);
 bool ParseAssetPriceHistory(const std::string& json,
                             std::vector<mojom::AssetTimePricePtr>* values);
+bool ParseAssetPriceHistory(const base::Value& records_v,
+                            std::vector<mojom::AssetTimePricePtr>* values);
 
 std::string ParseEstimatedTime(const std::string& json);
 mojom::GasEstimation1559Ptr ParseGasOracle(const std::string& json);
@@ -41,6 +41,9 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
     )");
 }
 
+// Price history over long timeframes runs to a few megabytes.
+constexpr size_t kMaxResponseBodySize = 8 * 1024 * 1024;
+
 std::string VectorToCommaSeparatedList(const std::vector<std::string>& assets) {
   std::stringstream ss;
   std::for_each(assets.begin(), assets.end(), [&ss](const std::string asset) {
@@ -161,9 +164,20 @@ void AssetRatioService::GetPrice(
     GetPriceCallback callback) {
   std::vector<std::string> from_assets_lower = VectorToLowerCase(from_assets);
   std::vector<std::string> to_assets_lower = VectorToLowerCase(to_assets);
-  auto internal_callback = base::BindOnce(
-      &AssetRatioService::OnGetPrice, weak_ptr_factory_.GetWeakPtr(),
-      from_assets_lower, to_assets_lower, std::move(callback));
+  auto convert = base::BindOnce(
+      [](std::vector<std::string> from_assets,
+         std::vector<std::string> to_assets, base::Value value)
+          -> absl::optional<std::vector<mojom::AssetPricePtr>> {
+        std::vector<mojom::AssetPricePtr> prices;
+        if (!ParseAssetPrice(value, from_assets, to_assets, &prices)) {
+          return absl::nullopt;
+        }
+        return prices;
+      },
+      from_assets_lower, to_assets_lower);
+  auto internal_callback =
+      base::BindOnce(&AssetRatioService::OnGetPrice,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
 
   base::flat_map<std::string, std::string> request_headers;
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -173,29 +187,24 @@ void AssetRatioService::GetPrice(
   }
   request_headers["x-brave-key"] = brave_key;
 
-  api_request_helper_->Request(
-      "GET", GetPriceURL(from_assets_lower, to_assets_lower, timeframe), "", "",
-      true, std::move(internal_callback), request_headers);
+  api_request_helper_->RequestJSONAs<std::vector<mojom::AssetPricePtr>>(
+      "GET", GetPriceURL(from_assets_lower, to_assets_lower, timeframe), "",
+      "", true, std::move(convert), std::move(internal_callback),
+      request_headers, kMaxResponseBodySize,
+      api_request_helper::JSONDecodeCaller::kWalletAssetRatio);
 }
 
 void AssetRatioService::OnGetPrice(
-    std::vector<std::string> from_assets,
-    std::vector<std::string> to_assets,
     GetPriceCallback callback,
     const int status,
-    const std::string& body,
+    absl::optional<std::vector<mojom::AssetPricePtr>> prices,
     const base::flat_map<std::string, std::string>& headers) {
-  std::vector<brave_wallet::mojom::AssetPricePtr> prices;
-  if (status < 200 || status > 299) {
-    std::move(callback).Run(false, std::move(prices));
-    return;
-  }
-  if (!ParseAssetPrice(body, from_assets, to_assets, &prices)) {
-    std::move(callback).Run(false, std::move(prices));
+  if (status < 200 || status > 299 || !prices) {
+    std::move(callback).Run(false, {});
     return;
   }
 
-  std::move(callback).Run(true, std::move(prices));
+  std::move(callback).Run(true, std::move(*prices));
 }
 
 void AssetRatioService::GetPriceHistory(
@@ -205,30 +214,36 @@ void AssetRatioService::GetPriceHistory(
     GetPriceHistoryCallback callback) {
   std::string asset_lower = base::ToLowerASCII(asset);
   std::string vs_asset_lower = base::ToLowerASCII(vs_asset);
+  auto convert = base::BindOnce(
+      [](base::Value value)
+          -> absl::optional<std::vector<mojom::AssetTimePricePtr>> {
+        std::vector<mojom::AssetTimePricePtr> values;
+        if (!ParseAssetPriceHistory(value, &values)) {
+          return absl::nullopt;
+        }
+        return values;
+      });
   auto internal_callback =
       base::BindOnce(&AssetRatioService::OnGetPriceHistory,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_->Request(
-      "GET", GetPriceHistoryURL(asset_lower, vs_asset_lower, timeframe), "", "",
-      true, std::move(internal_callback));
+  api_request_helper_->RequestJSONAs<std::vector<mojom::AssetTimePricePtr>>(
+      "GET", GetPriceHistoryURL(asset_lower, vs_asset_lower, timeframe), "",
+      "", true, std::move(convert), std::move(internal_callback), {},
+      kMaxResponseBodySize,
+      api_request_helper::JSONDecodeCaller::kWalletAssetRatio);
 }
 
 void AssetRatioService::OnGetPriceHistory(
     GetPriceHistoryCallback callback,
     const int status,
-    const std::string& body,
+    absl::optional<std::vector<mojom::AssetTimePricePtr>> values,
     const base::flat_map<std::string, std::string>& headers) {
-  std::vector<brave_wallet::mojom::AssetTimePricePtr> values;
-  if (status < 200 || status > 299) {
-    std::move(callback).Run(false, std::move(values));
-    return;
-  }
-  if (!ParseAssetPriceHistory(body, &values)) {
-    std::move(callback).Run(false, std::move(values));
+  if (status < 200 || status > 299 || !values) {
+    std::move(callback).Run(false, {});
     return;
   }
 
-  std::move(callback).Run(true, std::move(values));
+  std::move(callback).Run(true, std::move(*values));
 }
 
 // static
@@ -72,16 +72,15 @@ class AssetRatioService : public KeyedService, public mojom::AssetRatioService {
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
  private:
-  void OnGetPrice(std::vector<std::string> from_assets,
-                  std::vector<std::string> to_assets,
-                  GetPriceCallback callback,
-                  const int status,
-                  const std::string& body,
-                  const base::flat_map<std::string, std::string>& headers);
+  void OnGetPrice(
+      GetPriceCallback callback,
+      const int status,
+      absl::optional<std::vector<mojom::AssetPricePtr>> prices,
+      const base::flat_map<std::string, std::string>& headers);
   void OnGetPriceHistory(
       GetPriceHistoryCallback callback,
       const int status,
-      const std::string& body,
+      absl::optional<std::vector<mojom::AssetTimePricePtr>> values,
       const base::flat_map<std::string, std::string>& headers);
 
   void OnGetEstimatedTime(
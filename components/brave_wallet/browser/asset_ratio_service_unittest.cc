@@ -98,10 +98,10 @@ class AssetRatioServiceUnitTest : public testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_;
   std::unique_ptr<AssetRatioService> asset_ratio_service_;
 
  private:
-  base::test::TaskEnvironment task_environment_;
   network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
 };
@@ -162,7 +162,7 @@ TEST_F(AssetRatioServiceUnitTest, GetPrice) {
       base::BindOnce(&OnGetPrice, &callback_run, true,
                      std::move(expected_prices_response)));
 
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -192,7 +192,7 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceUppercase) {
       base::BindOnce(&OnGetPrice, &callback_run, true,
                      std::move(expected_prices_response)));
 
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -206,7 +206,7 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceError) {
       base::BindOnce(&OnGetPrice, &callback_run, false,
                      std::move(expected_prices_response)));
 
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -219,7 +219,7 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceUnexpectedResponse) {
       base::BindOnce(&OnGetPrice, &callback_run, false,
                      std::move(expected_prices_response)));
 
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -251,7 +251,7 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceHistory) {
       base::BindOnce(&OnGetPriceHistory, &callback_run, true,
                      std::move(expected_price_history_response)));
 
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -265,7 +265,7 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceHistoryError) {
       "bat", "usd", brave_wallet::mojom::AssetPriceTimeframe::OneDay,
       base::BindOnce(&OnGetPriceHistory, &callback_run, false,
                      std::move(expected_price_history_response)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -280,7 +280,7 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceHistoryUnexpectedResponse) {
       base::BindOnce(&OnGetPriceHistory, &callback_run, false,
                      std::move(expected_price_history_response)));
 
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -300,7 +300,7 @@ TEST_F(AssetRatioServiceUnitTest, GetEstimatedTime) {
   asset_ratio_service_->GetEstimatedTime(
       "2000000000",
       base::BindOnce(&OnGetEstimatedTime, &callback_run, true, "3615"));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -320,7 +320,7 @@ TEST_F(AssetRatioServiceUnitTest, GetEstimatedTimeEmptyResult) {
   asset_ratio_service_->GetEstimatedTime(
       "2000000000",
       base::BindOnce(&OnGetEstimatedTime, &callback_run, false, ""));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -330,7 +330,7 @@ TEST_F(AssetRatioServiceUnitTest, GetEstimatedTimeServerError) {
   asset_ratio_service_->GetEstimatedTime(
       "2000000000",
       base::BindOnce(&OnGetEstimatedTime, &callback_run, false, ""));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -245,6 +245,31 @@ const base::flat_map<std::string, std::string> kEnsRegistryContractAddressMap =
      {brave_wallet::mojom::kGoerliChainId,
       "0x00000000000C2E074eC69A0dFb2997BA6C7d2e1e"}};
 
+// Multicall3 is deployed at the same address on every chain it supports.
+const base::flat_map<std::string, std::string> kMulticallContractAddressMap =
+    {{brave_wallet::mojom::kMainnetChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kRopstenChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kRinkebyChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kGoerliChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kKovanChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kPolygonMainnetChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kBinanceSmartChainMainnetChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kAvalancheMainnetChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kFantomMainnetChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kCeloMainnetChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"},
+     {brave_wallet::mojom::kOptimismMainnetChainId,
+      "0xcA11bde05977b3631167028862bE2a173976CA11"}};
+
 std::string GetInfuraURLForKnownChainId(const std::string& chain_id) {
   auto subdomain = brave_wallet::GetInfuraSubdomainForKnownChainId(chain_id);
   if (subdomain.empty())
@@ -862,6 +887,12 @@ std::string GetEnsRegistryContractAddress(const std::string& chain_id) {
   return "";
 }
 
+std::string GetMulticallContractAddress(const std::string& chain_id) {
+  if (kMulticallContractAddressMap.contains(chain_id))
+    return kMulticallContractAddressMap.at(chain_id);
+  return "";
+}
+
 void AddCustomNetwork(PrefService* prefs, mojom::NetworkInfoPtr chain) {
   DCHECK(prefs);
 
@@ -100,6 +100,7 @@ std::string GetKnownEthNetworkId(const std::string& chain_id);
 std::string GetUnstoppableDomainsProxyReaderContractAddress(
     const std::string& chain_id);
 std::string GetEnsRegistryContractAddress(const std::string& chain_id);
+std::string GetMulticallContractAddress(const std::string& chain_id);
 
 // Append chain value to kBraveWalletCustomNetworks dictionary pref.
 void AddCustomNetwork(PrefService* prefs, mojom::NetworkInfoPtr chain);
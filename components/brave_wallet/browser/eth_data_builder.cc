@@ -6,6 +6,7 @@
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
 
 #include "base/logging.h"
+#include "brave/components/brave_wallet/common/eth_address.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/common/hash_utils.h"
 #include "brave/components/brave_wallet/common/hex_utils.h"
@@ -216,4 +217,85 @@ bool Addr(const std::string& domain, std::string* data) {
 
 }  // namespace ens
 
+namespace multicall {
+
+bool TryAggregate(const std::vector<std::pair<std::string, std::string>>& calls,
+                  std::string* data) {
+  const std::string function_hash =
+      GetFunctionHash("tryAggregate(bool,(address,bytes)[])");
+
+  std::string require_success;
+  if (!PadHexEncodedParameter(Uint256ValueToHex(0), &require_success)) {
+    return false;
+  }
+
+  std::string offset_for_array;
+  if (!PadHexEncodedParameter(Uint256ValueToHex(64), &offset_for_array)) {
+    return false;
+  }
+
+  std::string count;
+  if (!PadHexEncodedParameter(Uint256ValueToHex(calls.size()), &count)) {
+    return false;
+  }
+
+  std::vector<std::string> hex_strings = {function_hash, require_success,
+                                          offset_for_array, count};
+
+  // Each (address,bytes) tuple is dynamic, so the array starts with offsets
+  // to the encoded tuples, relative to the first offset.
+  std::vector<std::string> encoded_calls;
+  size_t call_offset = calls.size() * 32;
+  for (const auto& call : calls) {
+    if (!EthAddress::IsValidAddress(call.first) ||
+        !IsValidHexString(call.second) || call.second.length() % 2 != 0) {
+      return false;
+    }
+
+    std::string encoded_offset;
+    if (!PadHexEncodedParameter(Uint256ValueToHex(call_offset),
+                                &encoded_offset)) {
+      return false;
+    }
+    hex_strings.push_back(encoded_offset);
+
+    std::string padded_address;
+    if (!PadHexEncodedParameter(call.first, &padded_address)) {
+      return false;
+    }
+
+    std::string offset_for_bytes;
+    if (!PadHexEncodedParameter(Uint256ValueToHex(64), &offset_for_bytes)) {
+      return false;
+    }
+
+    const size_t bytes_len = (call.second.length() - 2) / 2;
+    std::string encoded_len;
+    if (!PadHexEncodedParameter(Uint256ValueToHex(bytes_len), &encoded_len)) {
+      return false;
+    }
+
+    std::string padded_bytes = call.second;
+    const size_t last_row_len = bytes_len % 32;
+    if (last_row_len != 0) {
+      padded_bytes += std::string((32 - last_row_len) * 2, '0');
+    }
+
+    std::string encoded_call;
+    if (!ConcatHexStrings({padded_address, offset_for_bytes, encoded_len,
+                           padded_bytes},
+                          &encoded_call)) {
+      return false;
+    }
+    encoded_calls.push_back(encoded_call);
+    call_offset += (encoded_call.length() - 2) / 2;
+  }
+
+  hex_strings.insert(hex_strings.end(), encoded_calls.begin(),
+                     encoded_calls.end());
+  return ConcatHexStrings(hex_strings, data);
+}
+
+}  // namespace multicall
+
 }  // namespace brave_wallet
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_DATA_BUILDER_H_
 
 #include <string>
+#include <utility>
 #include <vector>
 #include "base/values.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
@@ -73,6 +74,16 @@ bool Addr(const std::string& domain, std::string* data);
 
 }  // namespace ens
 
+namespace multicall {
+
+// Packs |calls|, pairs of (contract address, call data), into a single
+// tryAggregate(bool,(address,bytes)[]) call for a Multicall3 contract. Calls
+// that revert are reported individually rather than failing the aggregate.
+bool TryAggregate(const std::vector<std::pair<std::string, std::string>>& calls,
+                  std::string* data);
+
+}  // namespace multicall
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_DATA_BUILDER_H_
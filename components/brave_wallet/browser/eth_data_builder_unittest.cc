@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
 
+#include <string>
+
 #include "brave/components/brave_wallet/common/hex_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -205,4 +207,42 @@ TEST(EthCallDataBuilderTest, Addr) {
 
 }  // namespace ens
 
+namespace multicall {
+
+TEST(EthCallDataBuilderTest, TryAggregate) {
+  std::string balance_of;
+  ASSERT_TRUE(erc20::BalanceOf("0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f",
+                               &balance_of));
+
+  std::string data;
+  ASSERT_TRUE(TryAggregate(
+      {{"0x0d8775f648430679a709e98d2b0cb6250d2887ef", balance_of}}, &data));
+  EXPECT_EQ(data,
+            "0xbce38bd7"
+            // requireSuccess
+            "0000000000000000000000000000000000000000000000000000000000000000"
+            // Offset to calls
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            // Count of calls
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            // Offset to the first call
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            // target
+            "0000000000000000000000000d8775f648430679a709e98d2b0cb6250d2887ef"
+            // Offset to callData
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            // Length of callData
+            "0000000000000000000000000000000000000000000000000000000000000024"
+            "70a08231000000000000000000000000BFb30a082f650C2A15D0632f0e87bE4F"
+            "8e64460f00000000000000000000000000000000000000000000000000000000");
+
+  // Invalid contract address
+  EXPECT_FALSE(TryAggregate({{"0x1", balance_of}}, &data));
+  // Invalid call data
+  EXPECT_FALSE(TryAggregate(
+      {{"0x0d8775f648430679a709e98d2b0cb6250d2887ef", "hello"}}, &data));
+}
+
+}  // namespace multicall
+
 }  // namespace brave_wallet
@@ -6,6 +6,7 @@
 #include "brave/components/brave_wallet/browser/eth_data_parser.h"
 
 #include <map>
+#include <utility>
 
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
@@ -47,6 +48,25 @@ bool GetUint256HexFromData(const std::string& input,
   return true;
 }
 
+// Reads the 32 byte word at |byte_offset| of |input| as an offset or length,
+// which can never exceed the size of |input| itself.
+bool GetSizeFromData(const std::string& input,
+                     size_t byte_offset,
+                     size_t* size) {
+  CHECK(size);
+  const size_t input_size = input.length() / 2;
+  if (input_size < 32 || byte_offset > input_size - 32) {
+    return false;
+  }
+  uint256_t value;
+  if (!HexValueToUint256("0x" + input.substr(byte_offset * 2, 64), &value) ||
+      value > input_size) {
+    return false;
+  }
+  *size = static_cast<size_t>(value);
+  return true;
+}
+
 }  // namespace
 
 bool GetTransactionInfoFromData(const std::string& data,
@@ -145,4 +165,59 @@ bool GetTransactionInfoFromData(const std::string& data,
   return true;
 }
 
+namespace multicall {
+
+bool DecodeTryAggregateResult(
+    const std::string& data,
+    std::vector<absl::optional<std::string>>* results) {
+  CHECK(results);
+  if (!IsValidHexString(data) || data.length() % 2 != 0) {
+    return false;
+  }
+  const std::string input = data.substr(2);
+
+  size_t array_offset;
+  size_t count;
+  if (!GetSizeFromData(input, 0, &array_offset) ||
+      !GetSizeFromData(input, array_offset, &count)) {
+    return false;
+  }
+
+  // Offsets to the (bool,bytes) tuples are relative to the first offset.
+  const size_t elements_offset = array_offset + 32;
+  std::vector<absl::optional<std::string>> decoded;
+  for (size_t i = 0; i < count; ++i) {
+    size_t tuple_offset;
+    if (!GetSizeFromData(input, elements_offset + i * 32, &tuple_offset)) {
+      return false;
+    }
+    tuple_offset += elements_offset;
+
+    size_t success;
+    size_t bytes_offset;
+    size_t bytes_len;
+    if (!GetSizeFromData(input, tuple_offset, &success) ||
+        !GetSizeFromData(input, tuple_offset + 32, &bytes_offset) ||
+        !GetSizeFromData(input, tuple_offset + bytes_offset, &bytes_len)) {
+      return false;
+    }
+
+    const size_t bytes_start = tuple_offset + bytes_offset + 32;
+    if (bytes_start + bytes_len > input.length() / 2) {
+      return false;
+    }
+
+    if (success) {
+      decoded.push_back("0x" + input.substr(bytes_start * 2, bytes_len * 2));
+    } else {
+      decoded.push_back(absl::nullopt);
+    }
+  }
+
+  *results = std::move(decoded);
+  return true;
+}
+
+}  // namespace multicall
+
 }  // namespace brave_wallet
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -18,6 +19,17 @@ bool GetTransactionInfoFromData(const std::string& data,
                                 std::vector<std::string>* tx_params,
                                 std::vector<std::string>* tx_args);
 
+namespace multicall {
+
+// Decodes the (bool,bytes)[] returned by tryAggregate. Each element of
+// |results| is the hex encoded return data of the matching call, or nullopt
+// if that call reverted.
+bool DecodeTryAggregateResult(
+    const std::string& data,
+    std::vector<absl::optional<std::string>>* results);
+
+}  // namespace multicall
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_DATA_PARSER_H_
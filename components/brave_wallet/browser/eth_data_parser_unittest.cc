@@ -188,4 +188,45 @@ TEST(EthDataParser, GetTransactionInfoFromDataOther) {
       GetTransactionInfoFromData("hello", &tx_type, &tx_params, &tx_args));
 }
 
+TEST(EthDataParser, DecodeTryAggregateResult) {
+  std::vector<absl::optional<std::string>> results;
+  EXPECT_TRUE(multicall::DecodeTryAggregateResult(
+      "0x"
+      // Offset to results
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      // Count of results
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      // Offsets to each result
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "00000000000000000000000000000000000000000000000000000000000000c0"
+      // success, offset to returnData, length of returnData, returnData
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "00000000000000000000000000000000000000000000000166e12cfce39a0000"
+      // A reverted call with no returnData
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      &results));
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0], "0x00000000000000000000000000000000000000000000000166e12cfce39a0000");
+  EXPECT_FALSE(results[1]);
+
+  // Empty result, as returned when no contract is deployed at the address.
+  EXPECT_FALSE(multicall::DecodeTryAggregateResult("0x", &results));
+  // Truncated returnData
+  EXPECT_FALSE(multicall::DecodeTryAggregateResult(
+      "0x"
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000020",
+      &results));
+  // Invalid input
+  EXPECT_FALSE(multicall::DecodeTryAggregateResult("hello", &results));
+}
+
 }  // namespace brave_wallet
@@ -9,12 +9,15 @@
 
 #include "base/bind.h"
 #include "base/environment.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
+#include "brave/components/brave_wallet/browser/eth_data_parser.h"
 #include "brave/components/brave_wallet/browser/eth_requests.h"
 #include "brave/components/brave_wallet/browser/eth_response_parser.h"
 #include "brave/components/brave_wallet/browser/fil_requests.h"
@@ -124,6 +127,45 @@ void JsonRpcService::SetAPIRequestHelperForTesting(
 
 JsonRpcService::~JsonRpcService() {}
 
+JsonRpcService::BatchedRequest::BatchedRequest(
+    const std::string& json_payload,
+    RequestIntermediateCallback callback)
+    : json_payload(json_payload), callback(std::move(callback)) {}
+
+JsonRpcService::BatchedRequest::BatchedRequest(BatchedRequest&&) = default;
+
+JsonRpcService::BatchedRequest& JsonRpcService::BatchedRequest::operator=(
+    BatchedRequest&&) = default;
+
+JsonRpcService::BatchedRequest::~BatchedRequest() = default;
+
+JsonRpcService::AggregatedCall::AggregatedCall(
+    const std::string& contract,
+    const std::string& data,
+    RequestIntermediateCallback callback)
+    : contract(contract), data(data), callback(std::move(callback)) {}
+
+JsonRpcService::AggregatedCall::AggregatedCall(AggregatedCall&&) = default;
+
+JsonRpcService::AggregatedCall& JsonRpcService::AggregatedCall::operator=(
+    AggregatedCall&&) = default;
+
+JsonRpcService::AggregatedCall::~AggregatedCall() = default;
+
+JsonRpcService::PendingMulticall::PendingMulticall() = default;
+
+JsonRpcService::PendingMulticall::PendingMulticall(PendingMulticall&&) =
+    default;
+
+JsonRpcService::PendingMulticall& JsonRpcService::PendingMulticall::operator=(
+    PendingMulticall&&) = default;
+
+JsonRpcService::PendingMulticall::~PendingMulticall() = default;
+
+void JsonRpcService::SetBatchWindow(base::TimeDelta window) {
+  batch_window_ = window;
+}
+
 // static
 void JsonRpcService::MigrateMultichainNetworks(PrefService* prefs) {
   // custom networks
@@ -222,6 +264,287 @@ void JsonRpcService::RequestInternal(const std::string& json_payload,
                                std::move(callback), request_headers);
 }
 
+void JsonRpcService::RequestBatched(const std::string& json_payload,
+                                    const GURL& network_url,
+                                    RequestIntermediateCallback callback) {
+  DCHECK(network_url.is_valid());
+
+  absl::optional<uint256_t> block_number;
+  auto block_it = latest_block_numbers_.find(network_url);
+  if (block_it != latest_block_numbers_.end()) {
+    block_number = block_it->second;
+
+    auto cache_it = response_cache_.find({network_url, json_payload});
+    if (cache_it != response_cache_.end()) {
+      if (cache_it->second.block_number == block_it->second &&
+          cache_it->second.expiry > base::TimeTicks::Now()) {
+        base::SequencedTaskRunnerHandle::Get()->PostTask(
+            FROM_HERE,
+            base::BindOnce(std::move(callback), 200, cache_it->second.body,
+                           base::flat_map<std::string, std::string>()));
+        return;
+      }
+      response_cache_.erase(cache_it);
+    }
+  }
+
+  auto& batch = pending_batches_[network_url];
+  batch.emplace_back(
+      json_payload,
+      base::BindOnce(&JsonRpcService::OnBatchedRequestResult,
+                     weak_ptr_factory_.GetWeakPtr(), network_url, json_payload,
+                     block_number, std::move(callback)));
+
+  if (batch.size() >= kMaxBatchSize) {
+    auto requests = std::move(batch);
+    pending_batches_.erase(network_url);
+    FlushBatch(network_url, std::move(requests));
+    return;
+  }
+
+  if (!batch_timer_.IsRunning()) {
+    batch_timer_.Start(FROM_HERE, batch_window_,
+                       base::BindOnce(&JsonRpcService::FlushBatches,
+                                      weak_ptr_factory_.GetWeakPtr()));
+  }
+}
+
+void JsonRpcService::FlushBatches() {
+  auto pending_batches = std::move(pending_batches_);
+  pending_batches_.clear();
+  for (auto& batch : pending_batches)
+    FlushBatch(batch.first, std::move(batch.second));
+}
+
+void JsonRpcService::FlushBatch(const GURL& network_url,
+                                std::vector<BatchedRequest> requests) {
+  if (requests.size() == 1) {
+    RequestInternal(requests[0].json_payload, true, network_url,
+                    std::move(requests[0].callback));
+    return;
+  }
+
+  // Calls are renumbered by their position in the batch so that responses,
+  // which the node may return in any order, can be matched back to them.
+  base::Value batch(base::Value::Type::LIST);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    absl::optional<base::Value> call =
+        base::JSONReader::Read(requests[i].json_payload);
+    DCHECK(call && call->is_dict());
+    call->SetIntKey("id", static_cast<int>(i));
+    batch.Append(std::move(*call));
+  }
+
+  std::string json_payload;
+  base::JSONWriter::Write(batch, &json_payload);
+
+  RequestInternal(json_payload, true, network_url,
+                  base::BindOnce(&JsonRpcService::OnBatchResponse,
+                                 weak_ptr_factory_.GetWeakPtr(), network_url,
+                                 std::move(requests)));
+}
+
+void JsonRpcService::OnBatchResponse(
+    const GURL& network_url,
+    std::vector<BatchedRequest> requests,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  if (status < 200 || status > 299) {
+    for (auto& request : requests)
+      std::move(request.callback).Run(status, body, headers);
+    return;
+  }
+
+  std::vector<absl::optional<base::Value>> responses(requests.size());
+  absl::optional<base::Value> records_v = base::JSONReader::Read(
+      body, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                base::JSONParserOptions::JSON_PARSE_RFC);
+  if (records_v && records_v->is_list()) {
+    for (auto& response : records_v->GetList()) {
+      if (!response.is_dict())
+        continue;
+      absl::optional<int> id = response.FindIntKey("id");
+      if (!id || *id < 0 || static_cast<size_t>(*id) >= responses.size() ||
+          responses[*id])
+        continue;
+      responses[*id] = std::move(response);
+    }
+  }
+
+  // Nodes that do not support batches answer with a single error object, and
+  // some drop calls from a batch under load. Those calls are sent on their own.
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (!responses[i]) {
+      RequestInternal(requests[i].json_payload, true, network_url,
+                      std::move(requests[i].callback));
+      continue;
+    }
+
+    absl::optional<base::Value> call =
+        base::JSONReader::Read(requests[i].json_payload);
+    if (call && call->is_dict() && call->FindKey("id"))
+      responses[i]->SetKey("id", call->FindKey("id")->Clone());
+
+    std::string response_body;
+    base::JSONWriter::Write(*responses[i], &response_body);
+    std::move(requests[i].callback).Run(status, response_body, headers);
+  }
+}
+
+void JsonRpcService::OnBatchedRequestResult(
+    const GURL& network_url,
+    const std::string& json_payload,
+    absl::optional<uint256_t> block_number,
+    RequestIntermediateCallback callback,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  // Only results fetched at the latest known block are cached, and errors
+  // never are.
+  auto block_it = latest_block_numbers_.find(network_url);
+  base::Value result;
+  if (block_number && block_it != latest_block_numbers_.end() &&
+      block_it->second == *block_number && status >= 200 && status <= 299 &&
+      ParseResult(body, &result)) {
+    CachedResponse& cached = response_cache_[{network_url, json_payload}];
+    cached.block_number = *block_number;
+    cached.expiry = base::TimeTicks::Now() + kResponseCacheTTL;
+    cached.body = body;
+  }
+
+  std::move(callback).Run(status, body, headers);
+}
+
+void JsonRpcService::RequestAggregated(const std::string& chain_id,
+                                       const GURL& network_url,
+                                       const std::string& contract,
+                                       const std::string& data,
+                                       RequestIntermediateCallback callback) {
+  const std::string multicall_address = GetMulticallContractAddress(chain_id);
+  if (multicall_address.empty() ||
+      multicall_unsupported_networks_.contains(network_url)) {
+    RequestSingleEthCall(network_url,
+                         AggregatedCall(contract, data, std::move(callback)));
+    return;
+  }
+
+  auto& pending_multicall = pending_multicalls_[network_url];
+  pending_multicall.multicall_address = multicall_address;
+  pending_multicall.calls.emplace_back(contract, data, std::move(callback));
+
+  if (pending_multicall.calls.size() >= kMaxMulticallSize) {
+    auto pending = std::move(pending_multicall);
+    pending_multicalls_.erase(network_url);
+    FlushMulticall(network_url, std::move(pending));
+    return;
+  }
+
+  if (!multicall_timer_.IsRunning()) {
+    multicall_timer_.Start(FROM_HERE, batch_window_,
+                           base::BindOnce(&JsonRpcService::FlushMulticalls,
+                                          weak_ptr_factory_.GetWeakPtr()));
+  }
+}
+
+void JsonRpcService::RequestSingleEthCall(const GURL& network_url,
+                                          AggregatedCall call) {
+  RequestBatched(eth::eth_call("", call.contract, "", "", "", call.data,
+                               "latest"),
+                 network_url, std::move(call.callback));
+}
+
+void JsonRpcService::FlushMulticalls() {
+  auto pending_multicalls = std::move(pending_multicalls_);
+  pending_multicalls_.clear();
+  for (auto& pending : pending_multicalls)
+    FlushMulticall(pending.first, std::move(pending.second));
+}
+
+void JsonRpcService::FlushMulticall(const GURL& network_url,
+                                    PendingMulticall pending) {
+  std::vector<std::pair<std::string, std::string>> calls;
+  for (const auto& call : pending.calls)
+    calls.emplace_back(call.contract, call.data);
+
+  std::string data;
+  if (pending.calls.size() == 1 || !multicall::TryAggregate(calls, &data)) {
+    for (auto& call : pending.calls)
+      RequestSingleEthCall(network_url, std::move(call));
+    return;
+  }
+
+  RequestBatched(
+      eth::eth_call("", pending.multicall_address, "", "", "", data, "latest"),
+      network_url,
+      base::BindOnce(&JsonRpcService::OnMulticallResponse,
+                     weak_ptr_factory_.GetWeakPtr(), network_url,
+                     std::move(pending.calls)));
+}
+
+void JsonRpcService::OnMulticallResponse(
+    const GURL& network_url,
+    std::vector<AggregatedCall> calls,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  if (status < 200 || status > 299) {
+    for (auto& call : calls)
+      std::move(call.callback).Run(status, body, headers);
+    return;
+  }
+
+  std::string result;
+  std::vector<absl::optional<std::string>> results;
+  if (!eth::ParseEthCall(body, &result) ||
+      !multicall::DecodeTryAggregateResult(result, &results) ||
+      results.size() != calls.size()) {
+    // Calling an address without code succeeds with no return data.
+    if (result == "0x")
+      multicall_unsupported_networks_.insert(network_url);
+    for (auto& call : calls)
+      RequestSingleEthCall(network_url, std::move(call));
+    return;
+  }
+
+  for (size_t i = 0; i < calls.size(); ++i) {
+    // Reverted calls are repeated on their own so that callers see the
+    // node's error for them.
+    if (!results[i]) {
+      RequestSingleEthCall(network_url, std::move(calls[i]));
+      continue;
+    }
+
+    base::Value response(base::Value::Type::DICTIONARY);
+    response.SetStringKey("jsonrpc", "2.0");
+    response.SetIntKey("id", 1);
+    response.SetStringKey("result", *results[i]);
+    std::string response_body;
+    base::JSONWriter::Write(response, &response_body);
+    std::move(calls[i].callback).Run(status, response_body, headers);
+  }
+}
+
+void JsonRpcService::UpdateLatestBlockNumber(const GURL& network_url,
+                                             uint256_t block_number) {
+  auto block_it = latest_block_numbers_.find(network_url);
+  if (block_it != latest_block_numbers_.end() &&
+      block_it->second == block_number)
+    return;
+
+  latest_block_numbers_[network_url] = block_number;
+
+  // Drop everything cached for this network, and expired entries for
+  // networks whose blocks are no longer being tracked.
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (auto it = response_cache_.begin(); it != response_cache_.end();) {
+    if (it->first.first == network_url || it->second.expiry <= now)
+      it = response_cache_.erase(it);
+    else
+      ++it;
+  }
+}
+
 void JsonRpcService::FirePendingRequestCompleted(const std::string& chain_id,
                                                  const std::string& error) {
   for (const auto& observer : observers_) {
@@ -510,16 +833,17 @@ void JsonRpcService::SetCustomNetworkForTesting(const std::string& chain_id,
 }
 
 void JsonRpcService::GetBlockNumber(GetBlockNumberCallback callback) {
-  auto internal_callback =
-      base::BindOnce(&JsonRpcService::OnGetBlockNumber,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_blockNumber(), true,
-                  network_urls_[mojom::CoinType::ETH],
+  const GURL& network_url = network_urls_[mojom::CoinType::ETH];
+  auto internal_callback = base::BindOnce(
+      &JsonRpcService::OnGetBlockNumber, weak_ptr_factory_.GetWeakPtr(),
+      std::move(callback), network_url);
+  RequestInternal(eth::eth_blockNumber(), true, network_url,
                   std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetBlockNumber(
     GetBlockNumberCallback callback,
+    const GURL& network_url,
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
@@ -538,6 +862,9 @@ void JsonRpcService::OnGetBlockNumber(
     return;
   }
 
+  // EthBlockTracker polls this, so cached reads are invalidated as soon as the
+  // chain advances.
+  UpdateLatestBlockNumber(network_url, block_number);
   std::move(callback).Run(block_number, mojom::ProviderError::kSuccess, "");
 }
 
@@ -599,8 +926,8 @@ void JsonRpcService::GetBalance(const std::string& address,
     auto internal_callback =
         base::BindOnce(&JsonRpcService::OnEthGetBalance,
                        weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-    RequestInternal(eth::eth_getBalance(address, "latest"), true, network_url,
-                    std::move(internal_callback));
+    RequestBatched(eth::eth_getBalance(address, "latest"), network_url,
+                   std::move(internal_callback));
     return;
   } else if (coin == mojom::CoinType::FIL) {
     auto internal_callback =
@@ -779,8 +1106,8 @@ void JsonRpcService::GetERC20TokenBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC20TokenBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract, "", "", "", data, "latest"), true,
-                  network_url, std::move(internal_callback));
+  RequestAggregated(chain_id, network_url, contract, data,
+                    std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC20TokenBalance(
@@ -821,9 +1148,9 @@ void JsonRpcService::GetERC20TokenAllowance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC20TokenAllowance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(
-      eth::eth_call("", contract_address, "", "", "", data, "latest"), true,
-      network_urls_[mojom::CoinType::ETH], std::move(internal_callback));
+  RequestAggregated(chain_ids_[mojom::CoinType::ETH],
+                    network_urls_[mojom::CoinType::ETH], contract_address, data,
+                    std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC20TokenAllowance(
@@ -1324,9 +1651,9 @@ void JsonRpcService::GetERC721OwnerOf(const std::string& contract,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC721OwnerOf,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract, "", "", "", data, "latest"), true,
-                  network_urls_[mojom::CoinType::ETH],
-                  std::move(internal_callback));
+  RequestBatched(eth::eth_call("", contract, "", "", "", data, "latest"),
+                 network_urls_[mojom::CoinType::ETH],
+                 std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC721OwnerOf(
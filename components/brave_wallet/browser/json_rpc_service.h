@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_SERVICE_H_
 
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -14,8 +15,11 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_threadsafe.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
@@ -25,6 +29,7 @@
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/bindings/remote_set.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -43,6 +48,13 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       PrefService* prefs);
   ~JsonRpcService() override;
 
+  // Upper bound on the number of calls sent in one JSON-RPC batch request.
+  static constexpr size_t kMaxBatchSize = 100;
+  // Upper bound on the number of token calls packed into one multicall.
+  static constexpr size_t kMaxMulticallSize = 100;
+  // How long a cached read stays valid if no newer block has been seen.
+  static constexpr base::TimeDelta kResponseCacheTTL = base::Seconds(15);
+
   static void MigrateMultichainNetworks(PrefService* prefs);
 
   mojo::PendingRemote<mojom::JsonRpcService> MakeRemote();
@@ -239,6 +251,11 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   void SetAPIRequestHelperForTesting(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Balance lookups issued within |window| of each other are sent to the node
+  // as a single JSON-RPC 2.0 batch request. A zero window batches the calls
+  // made before control returns to the message loop.
+  void SetBatchWindow(base::TimeDelta window);
+
   // Solana JSON RPCs
   void GetSolanaBalance(const std::string& pubkey,
                         GetSolanaBalanceCallback callback) override;
@@ -272,6 +289,7 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   void RemoveChainIdRequest(const std::string& chain_id);
   void OnGetBlockNumber(
       GetBlockNumberCallback callback,
+      const GURL& network_url,
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
@@ -386,6 +404,86 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
                        bool auto_retry_on_network_change,
                        const GURL& network_url,
                        RequestIntermediateCallback callback);
+
+  // Read-only calls go through RequestBatched so that they are coalesced into
+  // batch requests and answered from |response_cache_| while the chain has not
+  // advanced past the block they were fetched at.
+  struct BatchedRequest {
+    BatchedRequest(const std::string& json_payload,
+                   RequestIntermediateCallback callback);
+    BatchedRequest(BatchedRequest&&);
+    BatchedRequest& operator=(BatchedRequest&&);
+    ~BatchedRequest();
+
+    std::string json_payload;
+    RequestIntermediateCallback callback;
+  };
+  struct CachedResponse {
+    uint256_t block_number = 0;
+    base::TimeTicks expiry;
+    std::string body;
+  };
+  void RequestBatched(const std::string& json_payload,
+                      const GURL& network_url,
+                      RequestIntermediateCallback callback);
+  void FlushBatches();
+  void FlushBatch(const GURL& network_url,
+                  std::vector<BatchedRequest> requests);
+  void OnBatchResponse(const GURL& network_url,
+                       std::vector<BatchedRequest> requests,
+                       const int status,
+                       const std::string& body,
+                       const base::flat_map<std::string, std::string>& headers);
+  void OnBatchedRequestResult(
+      const GURL& network_url,
+      const std::string& json_payload,
+      absl::optional<uint256_t> block_number,
+      RequestIntermediateCallback callback,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
+  void UpdateLatestBlockNumber(const GURL& network_url,
+                               uint256_t block_number);
+
+  // ERC-20 balanceOf and allowance calls go through RequestAggregated, which
+  // packs the calls made within the batch window into a single eth_call to the
+  // chain's Multicall3 contract, and falls back to individual eth_calls where
+  // that contract is not deployed.
+  struct AggregatedCall {
+    AggregatedCall(const std::string& contract,
+                   const std::string& data,
+                   RequestIntermediateCallback callback);
+    AggregatedCall(AggregatedCall&&);
+    AggregatedCall& operator=(AggregatedCall&&);
+    ~AggregatedCall();
+
+    std::string contract;
+    std::string data;
+    RequestIntermediateCallback callback;
+  };
+  struct PendingMulticall {
+    PendingMulticall();
+    PendingMulticall(PendingMulticall&&);
+    PendingMulticall& operator=(PendingMulticall&&);
+    ~PendingMulticall();
+
+    std::string multicall_address;
+    std::vector<AggregatedCall> calls;
+  };
+  void RequestAggregated(const std::string& chain_id,
+                         const GURL& network_url,
+                         const std::string& contract,
+                         const std::string& data,
+                         RequestIntermediateCallback callback);
+  void RequestSingleEthCall(const GURL& network_url, AggregatedCall call);
+  void FlushMulticalls();
+  void FlushMulticall(const GURL& network_url, PendingMulticall pending);
+  void OnMulticallResponse(
+      const GURL& network_url,
+      std::vector<AggregatedCall> calls,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
   void OnEthChainIdValidatedForOrigin(
       mojom::NetworkInfoPtr chain,
       const GURL& origin,
@@ -465,6 +563,19 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
 
   mojo::ReceiverSet<mojom::JsonRpcService> receivers_;
   PrefService* prefs_ = nullptr;
+
+  base::TimeDelta batch_window_;
+  base::OneShotTimer batch_timer_;
+  std::map<GURL, std::vector<BatchedRequest>> pending_batches_;
+  std::map<GURL, uint256_t> latest_block_numbers_;
+  // <(network_url, json_payload), response>
+  std::map<std::pair<GURL, std::string>, CachedResponse> response_cache_;
+
+  base::OneShotTimer multicall_timer_;
+  std::map<GURL, PendingMulticall> pending_multicalls_;
+  // Networks whose Multicall3 address turned out to have no contract.
+  base::flat_set<GURL> multicall_unsupported_networks_;
+
   base::WeakPtrFactory<JsonRpcService> weak_ptr_factory_;
 };
 
@@ -17,6 +17,7 @@
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
+#include "brave/components/brave_wallet/browser/eth_data_builder.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/keyring_service.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
@@ -382,6 +383,101 @@ class JsonRpcServiceUnitTest : public testing::Test {
         }));
   }
 
+  // Stands in for a node that answers eth_blockNumber, eth_getBalance and
+  // eth_call, counting the HTTP requests it receives. Batch responses are
+  // returned in reverse order, which JSON-RPC 2.0 allows.
+  void SetBatchInterceptor(const std::string& block_number,
+                           const std::string& balance,
+                           const std::string& call_result,
+                           bool supports_batches,
+                           size_t* request_count) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, block_number, balance, call_result, supports_batches,
+         request_count](const network::ResourceRequest& request) {
+          (*request_count)++;
+          base::StringPiece request_string(request.request_body->elements()
+                                               ->at(0)
+                                               .As<network::DataElementBytes>()
+                                               .AsStringPiece());
+          auto respond = [&](const base::Value& call) {
+            base::Value response(base::Value::Type::DICTIONARY);
+            response.SetStringKey("jsonrpc", "2.0");
+            response.SetKey("id", call.FindKey("id")->Clone());
+            const std::string* method = call.FindStringKey("method");
+            if (*method == "eth_blockNumber")
+              response.SetStringKey("result", block_number);
+            else if (*method == "eth_getBalance")
+              response.SetStringKey("result", balance);
+            else
+              response.SetStringKey("result", call_result);
+            return response;
+          };
+
+          absl::optional<base::Value> payload =
+              base::JSONReader::Read(request_string);
+          ASSERT_TRUE(payload);
+          std::string response_string;
+          if (payload->is_list() && !supports_batches) {
+            response_string =
+                R"({"jsonrpc":"2.0","id":null,"error":)"
+                R"({"code":-32600,"message":"Batch requests not supported"}})";
+          } else if (payload->is_list()) {
+            base::Value responses(base::Value::Type::LIST);
+            const auto& calls = payload->GetList();
+            for (size_t i = calls.size(); i > 0; --i)
+              responses.Append(respond(calls[i - 1]));
+            base::JSONWriter::Write(responses, &response_string);
+          } else {
+            base::JSONWriter::Write(respond(*payload), &response_string);
+          }
+          url_loader_factory_.ClearResponses();
+          url_loader_factory_.AddResponse(request.url.spec(), response_string);
+        }));
+  }
+
+  // Answers eth_calls, single or batched, with |multicall_result| when their
+  // data is |multicall_data| and with |call_result| otherwise.
+  void SetMulticallInterceptor(const std::string& multicall_data,
+                               const std::string& multicall_result,
+                               const std::string& call_result,
+                               size_t* request_count) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, multicall_data, multicall_result, call_result,
+         request_count](const network::ResourceRequest& request) {
+          (*request_count)++;
+          base::StringPiece request_string(request.request_body->elements()
+                                               ->at(0)
+                                               .As<network::DataElementBytes>()
+                                               .AsStringPiece());
+          auto respond = [&](const base::Value& call) {
+            const std::string* data =
+                call.FindListKey("params")->GetList()[0].FindStringKey("data");
+            base::Value response(base::Value::Type::DICTIONARY);
+            response.SetStringKey("jsonrpc", "2.0");
+            response.SetKey("id", call.FindKey("id")->Clone());
+            response.SetStringKey(
+                "result", *data == multicall_data ? multicall_result
+                                                  : call_result);
+            return response;
+          };
+
+          absl::optional<base::Value> payload =
+              base::JSONReader::Read(request_string);
+          ASSERT_TRUE(payload);
+          std::string response_string;
+          if (payload->is_list()) {
+            base::Value responses(base::Value::Type::LIST);
+            for (const auto& call : payload->GetList())
+              responses.Append(respond(call));
+            base::JSONWriter::Write(responses, &response_string);
+          } else {
+            base::JSONWriter::Write(respond(*payload), &response_string);
+          }
+          url_loader_factory_.ClearResponses();
+          url_loader_factory_.AddResponse(request.url.spec(), response_string);
+        }));
+  }
+
   void SetInvalidJsonInterceptor() {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&](const network::ResourceRequest& request) {
@@ -1400,6 +1496,229 @@ TEST_F(JsonRpcServiceUnitTest, GetERC20TokenBalance) {
   EXPECT_TRUE(callback_called);
 }
 
+TEST_F(JsonRpcServiceUnitTest, BatchesBalanceRequests) {
+  size_t request_count = 0;
+  SetBatchInterceptor(
+      "0x1", "0xb539d5",
+      "0x00000000000000000000000000000000000000000000000166e12cfce39a0000",
+      true, &request_count);
+
+  const std::vector<std::string> accounts = {
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      "0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f",
+      "0x983110309620D911731Ac0932219af06091b6744"};
+  const std::vector<std::string> contracts = {
+      "0x0d8775f648430679a709e98d2b0cb6250d2887ef",
+      "0x6b175474e89094c44da98b954eedeac495271d0f"};
+
+  // Localhost has no Multicall3 contract, so token balances are plain
+  // eth_calls.
+  size_t callbacks_called = 0;
+  for (const auto& account : accounts) {
+    json_rpc_service_->GetBalance(
+        account, mojom::CoinType::ETH, mojom::kLocalhostChainId,
+        base::BindLambdaForTesting([&](const std::string& balance,
+                                       mojom::ProviderError error,
+                                       const std::string& error_message) {
+          EXPECT_EQ(balance, "0xb539d5");
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          callbacks_called++;
+        }));
+    for (const auto& contract : contracts) {
+      json_rpc_service_->GetERC20TokenBalance(
+          contract, account, mojom::kLocalhostChainId,
+          base::BindLambdaForTesting([&](const std::string& balance,
+                                         mojom::ProviderError error,
+                                         const std::string& error_message) {
+            EXPECT_EQ(balance,
+                      "0x00000000000000000000000000000000000000000000000166e12"
+                      "cfce39a0000");
+            EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+            callbacks_called++;
+          }));
+    }
+  }
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(callbacks_called, 9u);
+  EXPECT_EQ(request_count, 1u);
+}
+
+TEST_F(JsonRpcServiceUnitTest, BatchFallsBackToSingleRequests) {
+  size_t request_count = 0;
+  SetBatchInterceptor("0x1", "0xb539d5", "0x", false, &request_count);
+
+  bool callback_called_1 = false;
+  bool callback_called_2 = false;
+  json_rpc_service_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1", mojom::CoinType::ETH,
+      mojom::kMainnetChainId,
+      base::BindOnce(&OnStringResponse, &callback_called_1,
+                     mojom::ProviderError::kSuccess, "", "0xb539d5"));
+  json_rpc_service_->GetBalance(
+      "0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f", mojom::CoinType::ETH,
+      mojom::kMainnetChainId,
+      base::BindOnce(&OnStringResponse, &callback_called_2,
+                     mojom::ProviderError::kSuccess, "", "0xb539d5"));
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_TRUE(callback_called_1);
+  EXPECT_TRUE(callback_called_2);
+  // The rejected batch plus one request per call.
+  EXPECT_EQ(request_count, 3u);
+}
+
+TEST_F(JsonRpcServiceUnitTest, CachesBalanceUntilNewBlock) {
+  size_t request_count = 0;
+  SetBatchInterceptor("0x1", "0xb539d5", "0x", true, &request_count);
+
+  auto get_block_number = [&]() {
+    base::RunLoop run_loop;
+    json_rpc_service_->GetBlockNumber(base::BindLambdaForTesting(
+        [&](uint256_t block_number, mojom::ProviderError error,
+            const std::string& error_message) {
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  };
+  auto get_balance = [&]() {
+    bool callback_called = false;
+    json_rpc_service_->GetBalance(
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::CoinType::ETH,
+        mojom::kLocalhostChainId,
+        base::BindOnce(&OnStringResponse, &callback_called,
+                       mojom::ProviderError::kSuccess, "", "0xb539d5"));
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(callback_called);
+  };
+
+  // Nothing is cached until the block number is known.
+  get_balance();
+  get_balance();
+  EXPECT_EQ(request_count, 2u);
+
+  get_block_number();
+  EXPECT_EQ(request_count, 3u);
+  get_balance();
+  EXPECT_EQ(request_count, 4u);
+  get_balance();
+  EXPECT_EQ(request_count, 4u);
+
+  // The same block does not invalidate the cache.
+  get_block_number();
+  get_balance();
+  EXPECT_EQ(request_count, 5u);
+
+  // A new block does.
+  SetBatchInterceptor("0x2", "0xb539d5", "0x", true, &request_count);
+  get_block_number();
+  get_balance();
+  EXPECT_EQ(request_count, 7u);
+}
+
+TEST_F(JsonRpcServiceUnitTest, AggregatesERC20CallsWithMulticall) {
+  const std::string contract = "0x0d8775f648430679a709e98d2b0cb6250d2887ef";
+  const std::string account_1 = "0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f";
+  const std::string account_2 = "0x983110309620D911731Ac0932219af06091b6744";
+  std::string balance_of_1;
+  std::string balance_of_2;
+  std::string multicall_data;
+  ASSERT_TRUE(erc20::BalanceOf(account_1, &balance_of_1));
+  ASSERT_TRUE(erc20::BalanceOf(account_2, &balance_of_2));
+  ASSERT_TRUE(multicall::TryAggregate(
+      {{contract, balance_of_1}, {contract, balance_of_2}}, &multicall_data));
+
+  // The first call succeeds inside the multicall, the second one reverts and
+  // is repeated on its own.
+  size_t request_count = 0;
+  SetMulticallInterceptor(
+      multicall_data,
+      "0x"
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "00000000000000000000000000000000000000000000000000000000000000c0"
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "00000000000000000000000000000000000000000000000166e12cfce39a0000"
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      "0x0000000000000000000000000000000000000000000000000000000000000001",
+      &request_count);
+
+  bool callback_called_1 = false;
+  bool callback_called_2 = false;
+  json_rpc_service_->GetERC20TokenBalance(
+      contract, account_1, mojom::kMainnetChainId,
+      base::BindOnce(&OnStringResponse, &callback_called_1,
+                     mojom::ProviderError::kSuccess, "",
+                     "0x00000000000000000000000000000000000000000000000166e12cf"
+                     "ce39a0000"));
+  json_rpc_service_->GetERC20TokenBalance(
+      contract, account_2, mojom::kMainnetChainId,
+      base::BindOnce(&OnStringResponse, &callback_called_2,
+                     mojom::ProviderError::kSuccess, "",
+                     "0x0000000000000000000000000000000000000000000000000000000"
+                     "000000001"));
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_TRUE(callback_called_1);
+  EXPECT_TRUE(callback_called_2);
+  EXPECT_EQ(request_count, 2u);
+}
+
+TEST_F(JsonRpcServiceUnitTest, MulticallFallsBackWhenNotDeployed) {
+  const std::string contract = "0x0d8775f648430679a709e98d2b0cb6250d2887ef";
+  const std::vector<std::string> accounts = {
+      "0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f",
+      "0x983110309620D911731Ac0932219af06091b6744"};
+  std::vector<std::pair<std::string, std::string>> calls;
+  for (const auto& account : accounts) {
+    std::string balance_of;
+    ASSERT_TRUE(erc20::BalanceOf(account, &balance_of));
+    calls.emplace_back(contract, balance_of);
+  }
+  std::string multicall_data;
+  ASSERT_TRUE(multicall::TryAggregate(calls, &multicall_data));
+
+  // No code at the Multicall3 address, so the aggregate returns nothing.
+  size_t request_count = 0;
+  SetMulticallInterceptor(
+      multicall_data, "0x",
+      "0x0000000000000000000000000000000000000000000000000000000000000001",
+      &request_count);
+
+  auto get_balances = [&]() {
+    size_t callbacks_called = 0;
+    for (const auto& account : accounts) {
+      json_rpc_service_->GetERC20TokenBalance(
+          contract, account, mojom::kMainnetChainId,
+          base::BindLambdaForTesting([&](const std::string& balance,
+                                         mojom::ProviderError error,
+                                         const std::string& error_message) {
+            EXPECT_EQ(balance,
+                      "0x0000000000000000000000000000000000000000000000000000"
+                      "000000000001");
+            EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+            callbacks_called++;
+          }));
+    }
+    base::RunLoop().RunUntilIdle();
+    EXPECT_EQ(callbacks_called, accounts.size());
+  };
+
+  // The multicall, then both calls in one batch.
+  get_balances();
+  EXPECT_EQ(request_count, 2u);
+
+  // The network is remembered, so the multicall is not attempted again.
+  get_balances();
+  EXPECT_EQ(request_count, 3u);
+}
+
 TEST_F(JsonRpcServiceUnitTest, GetERC20TokenAllowance) {
   bool callback_called = false;
   SetInterceptor(
@@ -28,10 +28,6 @@ namespace brave_wallet {
 bool ParseSwapResponse(const std::string& json,
                        bool expect_transaction_data,
                        mojom::SwapResponsePtr* swap_response) {
-  DCHECK(swap_response);
-  *swap_response = mojom::SwapResponse::New();
-  auto& response = *swap_response;
-
   // {
   //   "price":"1916.27547998814058355",
   //   "guaranteedPrice":"1935.438234788021989386",
@@ -62,9 +58,18 @@ bool ParseSwapResponse(const std::string& json,
     LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
     return false;
   }
+  return ParseSwapResponse(*records_v, expect_transaction_data, swap_response);
+}
+
+bool ParseSwapResponse(const base::Value& records_v,
+                       bool expect_transaction_data,
+                       mojom::SwapResponsePtr* swap_response) {
+  DCHECK(swap_response);
+  *swap_response = mojom::SwapResponse::New();
+  auto& response = *swap_response;
 
   const base::DictionaryValue* response_dict;
-  if (!records_v->GetAsDictionary(&response_dict)) {
+  if (!records_v.GetAsDictionary(&response_dict)) {
     return false;
   }
 
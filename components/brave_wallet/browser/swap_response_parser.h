@@ -7,6 +7,8 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_SWAP_RESPONSE_PARSER_H_
 
 #include <string>
+
+#include "base/values.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 
 namespace brave_wallet {
@@ -14,6 +16,9 @@ namespace brave_wallet {
 bool ParseSwapResponse(const std::string& json,
                        bool expect_transaction_data,
                        mojom::SwapResponsePtr* swap_response);
+bool ParseSwapResponse(const base::Value& records_v,
+                       bool expect_transaction_data,
+                       mojom::SwapResponsePtr* swap_response);
 
 }  // namespace brave_wallet
 
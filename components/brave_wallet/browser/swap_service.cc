@@ -7,7 +7,9 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "base/strings/stringprintf.h"
+#include "brave/components/api_request_helper/json_decoder.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/swap_response_parser.h"
@@ -41,6 +43,17 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
     )");
 }
 
+absl::optional<brave_wallet::mojom::SwapResponsePtr> ConvertSwapResponse(
+    bool expect_transaction_data,
+    base::Value value) {
+  auto swap_response = brave_wallet::mojom::SwapResponse::New();
+  if (!brave_wallet::ParseSwapResponse(value, expect_transaction_data,
+                                       &swap_response)) {
+    return absl::nullopt;
+  }
+  return swap_response;
+}
+
 bool IsMainnetNetworkSupported(const std::string& chain_id) {
   return (chain_id == brave_wallet::mojom::kMainnetChainId ||
           chain_id == brave_wallet::mojom::kPolygonMainnetChainId ||
@@ -235,14 +248,27 @@ void SwapService::OnGetPriceQuote(
     std::move(callback).Run(false, nullptr, body);
     return;
   }
-  auto swap_response = mojom::SwapResponse::New();
-  if (!ParseSwapResponse(body, false, &swap_response)) {
+  // 0x responses are parsed in the data_decoder sandbox.
+  api_request_helper::DecodeJSONAs<mojom::SwapResponsePtr>(
+      body, api_request_helper::JSONDecodeMode::kDataDecoder,
+      api_request_helper::JSONDecodeCaller::kWalletSwap,
+      base::BindOnce(&ConvertSwapResponse, false),
+      base::BindOnce(&SwapService::OnPriceQuoteParsed,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback),
+                     body));
+}
+
+void SwapService::OnPriceQuoteParsed(
+    GetPriceQuoteCallback callback,
+    const std::string& body,
+    absl::optional<mojom::SwapResponsePtr> swap_response) {
+  if (!swap_response) {
     std::move(callback).Run(false, nullptr,
                             "Could not parse response body: " + body);
     return;
   }
 
-  std::move(callback).Run(true, std::move(swap_response), absl::nullopt);
+  std::move(callback).Run(true, std::move(*swap_response), absl::nullopt);
 }
 
 void SwapService::GetTransactionPayload(
@@ -273,14 +299,26 @@ void SwapService::OnGetTransactionPayload(
     std::move(callback).Run(false, nullptr, body);
     return;
   }
-  auto swap_response = mojom::SwapResponse::New();
-  if (!ParseSwapResponse(body, true, &swap_response)) {
+  api_request_helper::DecodeJSONAs<mojom::SwapResponsePtr>(
+      body, api_request_helper::JSONDecodeMode::kDataDecoder,
+      api_request_helper::JSONDecodeCaller::kWalletSwap,
+      base::BindOnce(&ConvertSwapResponse, true),
+      base::BindOnce(&SwapService::OnTransactionPayloadParsed,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback),
+                     body));
+}
+
+void SwapService::OnTransactionPayloadParsed(
+    GetTransactionPayloadCallback callback,
+    const std::string& body,
+    absl::optional<mojom::SwapResponsePtr> swap_response) {
+  if (!swap_response) {
     std::move(callback).Run(false, nullptr,
                             "Could not parse response body: " + body);
     return;
   }
 
-  std::move(callback).Run(true, std::move(swap_response), absl::nullopt);
+  std::move(callback).Run(true, std::move(*swap_response), absl::nullopt);
 }
 
 void SwapService::IsSwapSupported(const std::string& chain_id,
@@ -21,6 +21,7 @@
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -73,6 +74,14 @@ class SwapService : public KeyedService, public mojom::SwapService {
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
+  void OnPriceQuoteParsed(
+      GetPriceQuoteCallback callback,
+      const std::string& body,
+      absl::optional<mojom::SwapResponsePtr> swap_response);
+  void OnTransactionPayloadParsed(
+      GetTransactionPayloadCallback callback,
+      const std::string& body,
+      absl::optional<mojom::SwapResponsePtr> swap_response);
 
   static GURL base_url_for_test_;
   api_request_helper::APIRequestHelper api_request_helper_;
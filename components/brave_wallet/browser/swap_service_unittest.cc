@@ -13,6 +13,7 @@
 #include "brave/components/brave_wallet/browser/swap_service.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
+#include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
 #include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
 #include "services/network/test/test_url_loader_factory.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -94,12 +95,13 @@ class SwapServiceUnitTest : public testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_;
+  data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<JsonRpcService> json_rpc_service_;
   std::unique_ptr<SwapService> swap_service_;
 
  private:
-  base::test::TaskEnvironment task_environment_;
   network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
 };
@@ -148,7 +150,7 @@ TEST_F(SwapServiceUnitTest, GetPriceQuote) {
       GetCannedSwapParams(),
       base::BindOnce(&OnRequestResponse, &callback_run, true,
                      std::move(expected_swap_response), absl::nullopt));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -160,7 +162,7 @@ TEST_F(SwapServiceUnitTest, GetPriceQuoteError) {
   swap_service_->GetPriceQuote(
       brave_wallet::mojom::SwapParams::New(),
       base::BindOnce(&OnRequestResponse, &callback_run, false, nullptr, error));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -172,7 +174,7 @@ TEST_F(SwapServiceUnitTest, GetPriceQuoteUnexpectedReturn) {
   swap_service_->GetPriceQuote(
       GetCannedSwapParams(),
       base::BindOnce(&OnRequestResponse, &callback_run, false, nullptr, error));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -226,7 +228,7 @@ TEST_F(SwapServiceUnitTest, GetTransactionPayload) {
       GetCannedSwapParams(),
       base::BindOnce(&OnRequestResponse, &callback_run, true,
                      std::move(expected_swap_response), absl::nullopt));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -255,7 +257,7 @@ TEST_F(SwapServiceUnitTest, GetTransactionPayloadError) {
   swap_service_->GetTransactionPayload(
       brave_wallet::mojom::SwapParams::New(),
       base::BindOnce(&OnRequestResponse, &callback_run, false, nullptr, error));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
@@ -267,7 +269,7 @@ TEST_F(SwapServiceUnitTest, GetTransactionPayloadUnexpectedReturn) {
   swap_service_->GetTransactionPayload(
       GetCannedSwapParams(),
       base::BindOnce(&OnRequestResponse, &callback_run, false, nullptr, error));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_run);
 }
 
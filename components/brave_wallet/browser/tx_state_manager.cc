@@ -7,6 +7,8 @@
 
 #include <utility>
 
+#include "base/auto_reset.h"
+#include "base/bind.h"
 #include "base/json/values_util.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
@@ -78,17 +80,75 @@ TxStateManager::TxStateManager(PrefService* prefs,
                                JsonRpcService* json_rpc_service)
     : prefs_(prefs), json_rpc_service_(json_rpc_service), weak_factory_(this) {
   DCHECK(json_rpc_service_);
+  pref_change_registrar_.Init(prefs_);
+  pref_change_registrar_.Add(
+      kBraveWalletTransactions,
+      base::BindRepeating(&TxStateManager::OnTransactionsPrefChanged,
+                          base::Unretained(this)));
 }
 
 TxStateManager::~TxStateManager() = default;
 
+// static
+absl::optional<TxStateManager::TxIndexEntry>
+TxStateManager::ValueToTxIndexEntry(const base::Value& value) {
+  absl::optional<int> status = value.FindIntKey("status");
+  const std::string* from = value.FindStringKey("from");
+  const base::Value* created_time = value.FindKey("created_time");
+  const base::Value* confirmed_time = value.FindKey("confirmed_time");
+  if (!status || !from || !created_time || !confirmed_time)
+    return absl::nullopt;
+
+  absl::optional<base::Time> created_time_from_value =
+      base::ValueToTime(created_time);
+  absl::optional<base::Time> confirmed_time_from_value =
+      base::ValueToTime(confirmed_time);
+  if (!created_time_from_value || !confirmed_time_from_value)
+    return absl::nullopt;
+
+  return TxIndexEntry{static_cast<mojom::TransactionStatus>(*status), *from,
+                      *created_time_from_value, *confirmed_time_from_value};
+}
+
+TxStateManager::TxIndex& TxStateManager::GetTxIndex(const std::string& prefix) {
+  auto iter = tx_indices_.find(prefix);
+  if (iter != tx_indices_.end())
+    return iter->second;
+
+  TxIndex& tx_index = tx_indices_[prefix];
+  const base::Value* dict = prefs_->GetDictionary(kBraveWalletTransactions);
+  const base::Value* network_dict = dict ? dict->FindPath(prefix) : nullptr;
+  if (!network_dict || !network_dict->is_dict())
+    return tx_index;
+
+  for (const auto it : network_dict->DictItems()) {
+    absl::optional<TxIndexEntry> entry = ValueToTxIndexEntry(it.second);
+    if (entry)
+      tx_index.emplace(it.first, std::move(*entry));
+  }
+  return tx_index;
+}
+
+void TxStateManager::OnTransactionsPrefChanged() {
+  if (!is_updating_pref_)
+    tx_indices_.clear();
+}
+
 void TxStateManager::AddOrUpdateTx(const TxMeta& meta) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  const std::string path = GetTxPrefPathPrefix() + "." + meta.id();
+  const std::string prefix = GetTxPrefPathPrefix();
+  bool is_add = false;
+  {
+    base::AutoReset<bool> updating_pref(&is_updating_pref_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    base::Value* dict = update.Get();
+    const std::string path = prefix + "." + meta.id();
+
+    is_add = dict->FindPath(path) == nullptr;
+    dict->SetPath(path, meta.ToValue());
+  }
+  GetTxIndex(prefix)[meta.id()] = {meta.status(), meta.from(),
+                                   meta.created_time(), meta.confirmed_time()};
 
-  bool is_add = dict->FindPath(path) == nullptr;
-  dict->SetPath(path, meta.ToValue());
   if (!is_add) {
     for (auto& observer : observers_)
       observer.OnTransactionStatusChanged(meta.ToTransactionInfo());
@@ -115,36 +175,54 @@ std::unique_ptr<TxMeta> TxStateManager::GetTx(const std::string& id) {
 }
 
 void TxStateManager::DeleteTx(const std::string& id) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  dict->RemovePath(GetTxPrefPathPrefix() + "." + id);
+  const std::string prefix = GetTxPrefPathPrefix();
+  {
+    base::AutoReset<bool> updating_pref(&is_updating_pref_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    base::Value* dict = update.Get();
+    dict->RemovePath(prefix + "." + id);
+  }
+
+  auto iter = tx_indices_.find(prefix);
+  if (iter != tx_indices_.end())
+    iter->second.erase(id);
 }
 
 void TxStateManager::WipeTxs() {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  dict->RemovePath(GetTxPrefPathPrefix());
+  const std::string prefix = GetTxPrefPathPrefix();
+  {
+    base::AutoReset<bool> updating_pref(&is_updating_pref_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    base::Value* dict = update.Get();
+    dict->RemovePath(prefix);
+  }
+
+  tx_indices_.erase(prefix);
 }
 
 std::vector<std::unique_ptr<TxMeta>> TxStateManager::GetTransactionsByStatus(
     absl::optional<mojom::TransactionStatus> status,
     absl::optional<std::string> from) {
   std::vector<std::unique_ptr<TxMeta>> result;
+  const std::string prefix = GetTxPrefPathPrefix();
   const base::Value* dict = prefs_->GetDictionary(kBraveWalletTransactions);
-  const base::Value* network_dict = dict->FindPath(GetTxPrefPathPrefix());
+  const base::Value* network_dict = dict->FindPath(prefix);
   if (!network_dict)
     return result;
 
-  for (const auto it : network_dict->DictItems()) {
-    std::unique_ptr<TxMeta> meta = ValueToTxMeta(it.second);
-    if (!meta) {
+  for (const auto& it : GetTxIndex(prefix)) {
+    if (status.has_value() && it.second.status != *status)
       continue;
-    }
-    if (!status.has_value() || meta->status() == *status) {
-      if (from.has_value() && meta->from() != *from)
-        continue;
-      result.push_back(std::move(meta));
-    }
+    if (from.has_value() && it.second.from != *from)
+      continue;
+
+    const base::Value* value = network_dict->FindKey(it.first);
+    if (!value)
+      continue;
+    std::unique_ptr<TxMeta> meta = ValueToTxMeta(*value);
+    if (!meta)
+      continue;
+    result.push_back(std::move(meta));
   }
   return result;
 }
@@ -154,24 +232,26 @@ void TxStateManager::RetireTxByStatus(mojom::TransactionStatus status,
   if (status != mojom::TransactionStatus::Confirmed &&
       status != mojom::TransactionStatus::Rejected)
     return;
-  auto tx_metas = GetTransactionsByStatus(status, absl::nullopt);
-  if (tx_metas.size() > max_num) {
-    TxMeta* oldest_meta = nullptr;
-    for (const auto& tx_meta : tx_metas) {
-      if (!oldest_meta) {
-        oldest_meta = tx_meta.get();
-      } else {
-        if (tx_meta->status() == mojom::TransactionStatus::Confirmed &&
-            tx_meta->confirmed_time() < oldest_meta->confirmed_time()) {
-          oldest_meta = tx_meta.get();
-        } else if (tx_meta->status() == mojom::TransactionStatus::Rejected &&
-                   tx_meta->created_time() < oldest_meta->created_time()) {
-          oldest_meta = tx_meta.get();
-        }
-      }
+
+  size_t count = 0;
+  std::string oldest_id;
+  base::Time oldest_time;
+  for (const auto& it : GetTxIndex(GetTxPrefPathPrefix())) {
+    if (it.second.status != status)
+      continue;
+
+    const base::Time time = status == mojom::TransactionStatus::Confirmed
+                                ? it.second.confirmed_time
+                                : it.second.created_time;
+    if (count == 0 || time < oldest_time) {
+      oldest_id = it.first;
+      oldest_time = time;
     }
-    DeleteTx(oldest_meta->id());
+    count++;
   }
+
+  if (count > max_num)
+    DeleteTx(oldest_id);
 }
 
 void TxStateManager::AddObserver(TxStateManager::Observer* observer) {
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_STATE_MANAGER_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_STATE_MANAGER_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,7 +16,9 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/time/time.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 class PrefService;
@@ -63,6 +66,28 @@ class TxStateManager {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(TxStateManagerUnitTest, TxOperations);
+
+  // The fields that txs are filtered and retired by, kept per network so
+  // that lookups only decode the TxMetas they return.
+  struct TxIndexEntry {
+    mojom::TransactionStatus status;
+    std::string from;
+    base::Time created_time;
+    base::Time confirmed_time;
+  };
+  using TxIndex = std::map<std::string, TxIndexEntry>;
+
+  static absl::optional<TxIndexEntry> ValueToTxIndexEntry(
+      const base::Value& value);
+
+  // Returns the index of the txs stored under |prefix|, building it from the
+  // transactions pref on first use.
+  TxIndex& GetTxIndex(const std::string& prefix);
+
+  // Drops all indices when the transactions pref is changed by anyone other
+  // than this manager, for example by another coin's state manager.
+  void OnTransactionsPrefChanged();
+
   void RetireTxByStatus(mojom::TransactionStatus status, size_t max_num);
 
   // Each derived class should implement its own ValueToTxMeta to create a
@@ -78,6 +103,10 @@ class TxStateManager {
 
   base::ObserverList<Observer> observers_;
 
+  std::map<std::string, TxIndex> tx_indices_;
+  bool is_updating_pref_ = false;
+  PrefChangeRegistrar pref_change_registrar_;
+
   base::WeakPtrFactory<TxStateManager> weak_factory_;
 };
 
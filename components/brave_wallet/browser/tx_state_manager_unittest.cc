@@ -18,6 +18,7 @@
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
 #include "services/network/test/test_url_loader_factory.h"
@@ -279,6 +280,37 @@ TEST_F(TxStateManagerUnitTest, GetTransactionsByStatus) {
   }
 }
 
+TEST_F(TxStateManagerUnitTest, GetTransactionsByStatusAfterExternalUpdate) {
+  prefs_.ClearPref(kBraveWalletTransactions);
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager_->AddOrUpdateTx(meta);
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Submitted,
+                                          absl::nullopt)
+                .size(),
+            1u);
+
+  // Txs written to the pref by anyone else must be picked up.
+  meta.set_id("002");
+  {
+    DictionaryPrefUpdate update(&prefs_, kBraveWalletTransactions);
+    update->SetPath("ethereum.mainnet.002", meta.ToValue());
+  }
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Submitted,
+                                          absl::nullopt)
+                .size(),
+            2u);
+
+  prefs_.ClearPref(kBraveWalletTransactions);
+  EXPECT_TRUE(
+      tx_state_manager_->GetTransactionsByStatus(absl::nullopt, absl::nullopt)
+          .empty());
+}
+
 TEST_F(TxStateManagerUnitTest, SwitchNetwork) {
   prefs_.ClearPref(kBraveWalletTransactions);
 